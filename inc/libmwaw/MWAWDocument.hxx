@@ -58,6 +58,7 @@ namespace librevenge
 class RVNGBinaryData;
 class RVNGDrawingInterface;
 class RVNGPresentationInterface;
+class RVNGPropertyList;
 class RVNGSpreadsheetInterface;
 class RVNGTextInterface;
 class RVNGInputStream;
@@ -267,6 +268,172 @@ public:
       \note encryption enum appears with MWAW_TEXT_VERSION==2 */
   static MWAWLIB Confidence isFileFormatSupported(librevenge::RVNGInputStream *input, Type &type, Kind &kind);
 
+  /** an opaque class used to store the result of a file format
+      detection: the unwrapped input, its resource fork and the file
+      header. It allows to parse a file without redoing the detection.
+
+      \note this class appears with MWAW_INTERFACE_VERSION==3 */
+  class DetectionHandle;
+
+  /** Analyzes the content of an input stream to see if it can be parsed
+      and returns a handle which can be used to parse the input
+      \param input The input stream
+      \param type The document type ( filled if the file is supported )
+      \param kind The document kind ( filled if the file is supported )
+      \param handle The detection handle ( set if the file is
+      supported, nullptr otherwise ). It must be released with
+      releaseDetectionHandle
+      \return A confidence value which represents the likelyhood that the content from
+      the input stream can be parsed
+
+      \note the handle keeps a pointer to input, so input must not be
+      destroyed before the handle
+
+      \note this function appears with MWAW_INTERFACE_VERSION==3 */
+  static MWAWLIB Confidence isFileFormatSupported(librevenge::RVNGInputStream *input, Type &type, Kind &kind, DetectionHandle *&handle);
+  /** Releases a handle created by isFileFormatSupported
+
+      \note this function appears with MWAW_INTERFACE_VERSION==3 */
+  static MWAWLIB void releaseDetectionHandle(DetectionHandle *handle);
+
+  /** Creates an input stream which maps a file in memory. The data
+      are then directly read in the mapped file, ie. without any copy.
+
+      \param fileName the file name
+      \return a new input stream (which must be deleted by the caller) or
+      nullptr if the file can not be mapped or if it seems to be a
+      structured (OLE or Zip) file. In this case, a
+      librevenge::RVNGFileStream must be used to read the file.
+
+      \note this function appears with MWAW_INTERFACE_VERSION==2 */
+  static MWAWLIB librevenge::RVNGInputStream *createMappedFileStream(char const *fileName);
+
+  /** Sets the maximum number of threads used to check the candidate
+      formats of a file in isFileFormatSupported. By default, only one
+      thread is used.
+
+      When several formats are possible and when the input is a memory
+      mapped file (see createMappedFileStream) of at least 1 MiB (data
+      and resource forks), the candidates are then checked
+      simultaneously, each in its own thread with its own reading
+      position, and the result is the same as the one obtained by
+      checking the candidates one by one. The smaller files are always
+      checked in the calling thread, as creating the threads would cost
+      more than the checks.
+
+      \param numThreads the maximum number of threads (<=1 means no parallel check)
+
+      \note this function appears with MWAW_INTERFACE_VERSION==4 */
+  static MWAWLIB void setNumDetectionThreads(int numThreads);
+
+  /** a class used to define some options which change how a document is parsed
+
+      \note this class appears with MWAW_INTERFACE_VERSION==5. Its
+      options are stored in the library and are only accessible with
+      its functions, so new options can be added without changing the
+      class size. */
+  class ParseOptions
+  {
+  public:
+    //! constructor: by default, the whole document is sent
+    MWAWLIB ParseOptions();
+    //! copy constructor
+    MWAWLIB ParseOptions(ParseOptions const &orig);
+    //! copy operator
+    MWAWLIB ParseOptions &operator=(ParseOptions const &orig);
+    //! destructor
+    MWAWLIB ~ParseOptions();
+
+    /** sets a flag to only retrieve the text of a text document: the
+        character and paragraph properties are not sent, the pictures
+        and the shapes are ignored and, when possible, the parsers do
+        not decode them. The text boxes, the tables, the notes and the
+        headers/footers are still sent. */
+    MWAWLIB void setTextOnly(bool textOnly);
+    //! returns true if only the text of a text document is retrieved
+    MWAWLIB bool isTextOnly() const;
+
+    /** sets the maximum number of pages (or slides) to send, 0 means
+        all the pages. If set, the sending of the document stops once the
+        last requested page is sent, the objects anchored to the following
+        pages are not sent.
+
+        \note the parsers still read all the document's zones before
+        sending the first page, so only the sending time depends on the
+        number of sent pages.
+
+        \note this function appears with MWAW_INTERFACE_VERSION==7 and
+        the option is used by the text, the graphic and the presentation
+        parsers */
+    MWAWLIB void setMaxPages(int maxPages);
+    /** returns the maximum number of pages (or slides) to send, 0 means all the pages
+
+        \note this function appears with MWAW_INTERFACE_VERSION==7 */
+    MWAWLIB int getMaxPages() const;
+
+    /** sets a flag to send the bitmaps without encoding them: the
+        pixels of a bitmap are then sent with mimeType="image/mwaw-raw"
+        (see decodeBitmap for the data format) instead of being
+        compressed in a PNG file. This is useful if the bitmaps are
+        converted or resized anyway.
+
+        \note this function appears with MWAW_INTERFACE_VERSION==9 */
+    MWAWLIB void setRawBitmaps(bool rawBitmaps);
+    /** returns true if the bitmaps are sent without being encoded
+
+        \note this function appears with MWAW_INTERFACE_VERSION==9 */
+    MWAWLIB bool useRawBitmaps() const;
+
+    //! the deflate strategies which can be used to compress the bitmaps in PNG files
+    enum PNGStrategy { PNG_Default, PNG_Filtered, PNG_RLE, PNG_HuffmanOnly };
+    /** sets the deflate compression level used to encode the bitmaps
+        in PNG files: -1 (zlib default), 0 (no compression), 1 (fast),
+        ..., 9 (best). By default, the level is 3.
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB void setPNGCompressionLevel(int level);
+    /** returns the deflate compression level used to encode the bitmaps in PNG files
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB int getPNGCompressionLevel() const;
+    /** sets the deflate strategy used to encode the bitmaps in PNG files
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB void setPNGStrategy(PNGStrategy strategy);
+    /** returns the deflate strategy used to encode the bitmaps in PNG files
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB PNGStrategy getPNGStrategy() const;
+    /** sets a flag to choose for each row of a true color bitmap the
+        PNG filter which seems the best, instead of not filtering the
+        rows. This often creates smaller files but is slower.
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB void setPNGAdaptiveFiltering(bool adaptiveFiltering);
+    /** returns true if the rows of the true color bitmaps are filtered
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB bool usePNGAdaptiveFiltering() const;
+    /** sets the maximum number of threads used to compress a bitmap
+        (by default 1). If more than one, the big bitmaps are split in
+        bands of rows which are compressed simultaneously and stored in
+        one PNG stream, the small bitmaps are always compressed in the
+        calling thread.
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB void setPNGNumThreads(int numThreads);
+    /** returns the maximum number of threads used to compress a bitmap
+
+        \note this function appears with MWAW_INTERFACE_VERSION==8 */
+    MWAWLIB int getPNGNumThreads() const;
+
+  private:
+    //! the options' storage
+    struct Data;
+    //! the options
+    Data *m_data;
+  };
+
   // ------------------------------------------------------------
   // the different main parsers
   // ------------------------------------------------------------
@@ -314,6 +481,83 @@ public:
   */
   static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=nullptr);
 
+  /** Parses the input stream content of a detection handle created by
+     isFileFormatSupported. It will make callbacks to the functions provided by a
+     librevenge::RVNGTextInterface class implementation when needed.
+     \param handle The detection handle
+     \param documentInterface A RVNGTextInterface implementation
+     \param password The file password
+
+     \note this function appears with MWAW_INTERFACE_VERSION==3
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGTextInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content of a detection handle created by
+     isFileFormatSupported, see parse(DetectionHandle *, librevenge::RVNGTextInterface *, char const *)
+
+     \note this function appears with MWAW_INTERFACE_VERSION==3
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGDrawingInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content of a detection handle created by
+     isFileFormatSupported, see parse(DetectionHandle *, librevenge::RVNGTextInterface *, char const *)
+
+     \note this function appears with MWAW_INTERFACE_VERSION==3
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGPresentationInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content of a detection handle created by
+     isFileFormatSupported, see parse(DetectionHandle *, librevenge::RVNGTextInterface *, char const *)
+
+     \note this function appears with MWAW_INTERFACE_VERSION==3
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content using some parse options, see
+     parse(librevenge::RVNGInputStream *, librevenge::RVNGTextInterface *, char const *)
+     \note this function appears with MWAW_INTERFACE_VERSION==5
+  */
+  static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+  /** Parses the input stream content of a detection handle using some parse options, see
+     parse(DetectionHandle *, librevenge::RVNGTextInterface *, char const *)
+     \note this function appears with MWAW_INTERFACE_VERSION==5
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+  /** Parses the input stream content using some parse options, see
+     parse(librevenge::RVNGInputStream *, librevenge::RVNGDrawingInterface *, char const *)
+     \note this function appears with MWAW_INTERFACE_VERSION==7
+  */
+  static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+  /** Parses the input stream content of a detection handle using some parse options, see
+     parse(DetectionHandle *, librevenge::RVNGDrawingInterface *, char const *)
+     \note this function appears with MWAW_INTERFACE_VERSION==7
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+  /** Parses the input stream content using some parse options, see
+     parse(librevenge::RVNGInputStream *, librevenge::RVNGPresentationInterface *, char const *)
+     \note this function appears with MWAW_INTERFACE_VERSION==7
+  */
+  static MWAWLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+  /** Parses the input stream content of a detection handle using some parse options, see
+     parse(DetectionHandle *, librevenge::RVNGPresentationInterface *, char const *)
+     \note this function appears with MWAW_INTERFACE_VERSION==7
+  */
+  static MWAWLIB Result parse(DetectionHandle *handle, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+
+  /** Retrieves the document meta data (title, author, ...) without
+     parsing the document: only the file header and the summary zones
+     are read, so this is much faster than a parse call.
+
+     \param input The input stream
+     \param metaData The property list which receives the meta data; it
+     is left empty if the format does not store any meta data
+     \return A value that indicates whether the file was recognized
+     \note this function appears with MWAW_INTERFACE_VERSION==6
+  */
+  static MWAWLIB Result getMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData);
+  /** Retrieves the meta data of the input stream of a detection handle
+     created by isFileFormatSupported, see getMetaData(librevenge::RVNGInputStream *, librevenge::RVNGPropertyList &)
+
+     \note this function appears with MWAW_INTERFACE_VERSION==6
+  */
+  static MWAWLIB Result getMetaData(DetectionHandle *handle, librevenge::RVNGPropertyList &metaData);
+
   // ------------------------------------------------------------
   // decoders of the embedded zones created by libmwaw
   // ------------------------------------------------------------
@@ -351,6 +595,30 @@ public:
 
    \note Reserved for future use. Actually, it only returns false. */
   static MWAWLIB bool decodeText(librevenge::RVNGBinaryData const &binary, librevenge::RVNGTextInterface *documentInterface);
+
+  /** Encodes the bitmap contained in the binary data in a picture file (in general a PNG file). The input is
+    normally send to a librevenge::RVNGXXXInterface with mimeType="image/mwaw-raw" when the parse options
+    use raw bitmaps (see ParseOptions::setRawBitmaps). It begins with a 20 bytes header (the numbers are stored in big endian):
+    - the 4 characters "MRAW",
+    - the width and the height (4 bytes each),
+    - the number of bits by pixel (2 bytes): 1 for a black and white bitmap (the bit 1 is black),
+    8 or 16 for an indexed bitmap, 24 for a RGB bitmap and 32 for a RGBA bitmap,
+    - 2 unused bytes,
+    - the number of colors of the palette (4 bytes),
+
+    followed by the palette (4 bytes by color: red, green, blue and alpha) and by the rows: each row
+    is stored in (width*bitsByPixel+7)/8 bytes, the first pixel corresponding to the high bits.
+
+   \param binary the bitmap data,
+   \param result the picture file, ie. the data sent when the parse options do not use raw bitmaps.
+
+   \note this function appears with MWAW_INTERFACE_VERSION==9 */
+  static MWAWLIB bool decodeBitmap(librevenge::RVNGBinaryData const &binary, librevenge::RVNGBinaryData &result);
+  /** Encodes the bitmap contained in the binary data in a picture file using the PNG options
+    of a ParseOptions, see decodeBitmap(librevenge::RVNGBinaryData const &, librevenge::RVNGBinaryData &)
+
+   \note this function appears with MWAW_INTERFACE_VERSION==9 */
+  static MWAWLIB bool decodeBitmap(librevenge::RVNGBinaryData const &binary, librevenge::RVNGBinaryData &result, ParseOptions const &options);
 };
 
 #endif /* MWAWDOCUMENT_HXX */
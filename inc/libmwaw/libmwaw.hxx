@@ -71,8 +71,16 @@ recommended to launch the tests in a empty repository...
 
 /** Defines the mwaw interface version, introduced in 0.3.17
     - 1: add types MWAW_T_RESERVED10 ... MWAW_T_RESERVED29
+    - 2: add MWAWDocument::createMappedFileStream
+    - 3: add MWAWDocument::DetectionHandle and the functions which use it
+    - 4: add MWAWDocument::setNumDetectionThreads
+    - 5: add MWAWDocument::ParseOptions and the parse functions which use it
+    - 6: add MWAWDocument::getMetaData
+    - 7: add MWAWDocument::ParseOptions::setMaxPages and the graphic/presentation parse functions which use ParseOptions
+    - 8: add MWAWDocument::ParseOptions::setPNGCompressionLevel and the other functions which define how the bitmaps are encoded in PNG files
+    - 9: add MWAWDocument::ParseOptions::setRawBitmaps and MWAWDocument::decodeBitmap
  */
-#define MWAW_INTERFACE_VERSION 1
+#define MWAW_INTERFACE_VERSION 9
 /** Defines the database possible conversion (actually none) */
 #define MWAW_DATABASE_VERSION 0
 /** Defines the vector graphic possible conversion:
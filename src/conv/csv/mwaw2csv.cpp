@@ -144,8 +144,9 @@ int main(int argc, char *argv[])
 
   MWAWDocument::Kind kind;
   auto confidence = MWAWDocument::MWAW_C_NONE;
-  auto input=libmwawHelper::isSupported(file, confidence, kind);
-  if (!input || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  std::shared_ptr<MWAWDocument::DetectionHandle> handle;
+  auto input=libmwawHelper::isSupported(file, confidence, kind, handle);
+  if (!input || !handle || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
     fprintf(stderr,"ERROR: Unsupported file format!\n");
     return 1;
   }
@@ -160,7 +161,7 @@ int main(int argc, char *argv[])
     librevenge::RVNGCSVSpreadsheetGenerator listenerImpl(vec, generateFormula);
     listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
     listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
-    error= MWAWDocument::parse(input.get(), &listenerImpl);
+    error= MWAWDocument::parse(handle.get(), &listenerImpl);
   }
   catch (MWAWDocument::Result const &err) {
     error=err;
@@ -52,6 +52,21 @@
 
 namespace libmwawHelper
 {
+////////////////////////////////////////////////////////////
+// static function to create a RVNGInputStream for a file
+////////////////////////////////////////////////////////////
+
+/** creates an input stream for a file: on linux, try first to map
+    the file in memory, if this is not possible, use a RVNGFileStream */
+static librevenge::RVNGInputStream *createFileStream(char const *fName)
+{
+#if defined(__linux__) && defined(MWAW_INTERFACE_VERSION) && MWAW_INTERFACE_VERSION>=2
+  librevenge::RVNGInputStream *res=MWAWDocument::createMappedFileStream(fName);
+  if (res) return res;
+#endif
+  return new librevenge::RVNGFileStream(fName);
+}
+
 #ifndef __EMSCRIPTEN__
 ////////////////////////////////////////////////////////////
 // static class to create a RVNGInputStream for some data
@@ -314,7 +329,7 @@ private:
 librevenge::RVNGInputStream *FolderStream::getSubStreamByName(const char *name)
 {
   if (m_nameToPathMap.find(name) != m_nameToPathMap.end())
-    return new librevenge::RVNGFileStream(m_nameToPathMap.find(name)->second.c_str());
+    return createFileStream(m_nameToPathMap.find(name)->second.c_str());
   if (m_nameToBufferMap.find(name) != m_nameToBufferMap.end())
     return new StringStream(m_nameToBufferMap.find(name)->second);
   return 0;
@@ -423,27 +438,45 @@ catch (...)
 // main functions
 ////////////////////////////////////////////////////////////
 
+/** creates a shared pointer on a detection handle which also keeps
+    the input alive */
+static std::shared_ptr<MWAWDocument::DetectionHandle> createHandle
+(std::shared_ptr<librevenge::RVNGInputStream> const &input, MWAWDocument::DetectionHandle *handle)
+{
+  // the deleter keeps a copy of input, so the input is destroyed after the handle
+  return std::shared_ptr<MWAWDocument::DetectionHandle>(handle, [input](MWAWDocument::DetectionHandle *hdl) {
+    MWAWDocument::releaseDetectionHandle(hdl);
+  });
+}
+
 std::shared_ptr<librevenge::RVNGInputStream> isSupported
-(char const *filename, MWAWDocument::Confidence &confidence, MWAWDocument::Kind &kind)
+(char const *filename, MWAWDocument::Confidence &confidence, MWAWDocument::Kind &kind,
+ std::shared_ptr<MWAWDocument::DetectionHandle> &handle)
 {
-  std::shared_ptr<librevenge::RVNGInputStream> input(new librevenge::RVNGFileStream(filename));
+  handle.reset();
+  std::shared_ptr<librevenge::RVNGInputStream> input(createFileStream(filename));
   MWAWDocument::Type type;
+  MWAWDocument::DetectionHandle *detection=nullptr;
 #ifndef __EMSCRIPTEN__
   try {
     auto mimeInput=createFolderInput(filename, *input);
     if (mimeInput) {
-      confidence=MWAWDocument::isFileFormatSupported(mimeInput.get(), type, kind);
+      confidence=MWAWDocument::isFileFormatSupported(mimeInput.get(), type, kind, detection);
+      handle=createHandle(mimeInput, detection);
       if (confidence == MWAWDocument::MWAW_C_EXCELLENT)
         return mimeInput;
+      handle.reset();
     }
   }
   catch (...) {
   }
 #endif
   try {
-    confidence = MWAWDocument::isFileFormatSupported(input.get(), type, kind);
+    confidence = MWAWDocument::isFileFormatSupported(input.get(), type, kind, detection);
+    handle=createHandle(input, detection);
     if (confidence == MWAWDocument::MWAW_C_EXCELLENT)
       return input;
+    handle.reset();
   }
   catch (...) {
   }
@@ -45,10 +45,15 @@
 namespace libmwawHelper
 {
 /** check if a file is supported, if so returns the input stream
- the confidence, ... If not, returns an empty input stream.
+ the confidence, ... and a detection handle which can be used to parse
+ the input without redoing the detection. If not, returns an empty
+ input stream.
+
+ \note the handle keeps a reference to the input stream
 */
 std::shared_ptr<librevenge::RVNGInputStream> isSupported
-(char const *filename, MWAWDocument::Confidence &confidence, MWAWDocument::Kind &kind);
+(char const *filename, MWAWDocument::Confidence &confidence, MWAWDocument::Kind &kind,
+ std::shared_ptr<MWAWDocument::DetectionHandle> &handle);
 /** check for error, if yes, print an error message and returns
     true. If not return false */
 bool checkErrorAndPrintMessage(MWAWDocument::Result result);
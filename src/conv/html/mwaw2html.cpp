@@ -93,8 +93,9 @@ int main(int argc, char *argv[])
 
   MWAWDocument::Kind kind;
   auto confidence = MWAWDocument::MWAW_C_NONE;
-  auto input=libmwawHelper::isSupported(file, confidence, kind);
-  if (!input || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  std::shared_ptr<MWAWDocument::DetectionHandle> handle;
+  auto input=libmwawHelper::isSupported(file, confidence, kind, handle);
+  if (!input || !handle || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
@@ -106,7 +107,7 @@ int main(int argc, char *argv[])
   librevenge::RVNGString document;
   try {
     librevenge::RVNGHTMLTextGenerator documentGenerator(document);
-    error = MWAWDocument::parse(input.get(), &documentGenerator);
+    error = MWAWDocument::parse(handle.get(), &documentGenerator);
   }
   catch (MWAWDocument::Result &err) {
     error=err;
@@ -90,8 +90,9 @@ int main(int argc, char *argv[])
 
   MWAWDocument::Kind kind;
   auto confidence = MWAWDocument::MWAW_C_NONE;
-  auto input=libmwawHelper::isSupported(file, confidence, kind);
-  if (!input || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  std::shared_ptr<MWAWDocument::DetectionHandle> handle;
+  auto input=libmwawHelper::isSupported(file, confidence, kind, handle);
+  if (!input || !handle || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
@@ -100,19 +101,19 @@ int main(int argc, char *argv[])
   try {
     if (kind == MWAWDocument::MWAW_K_DRAW || kind == MWAWDocument::MWAW_K_PAINT) {
       librevenge::RVNGRawDrawingGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
     }
     else if (kind == MWAWDocument::MWAW_K_SPREADSHEET || kind == MWAWDocument::MWAW_K_DATABASE) {
       librevenge::RVNGRawSpreadsheetGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
     }
     else if (kind == MWAWDocument::MWAW_K_PRESENTATION) {
       librevenge::RVNGRawPresentationGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
     }
     else {
       librevenge::RVNGRawTextGenerator documentGenerator(printIndentLevel);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
     }
   }
   catch (MWAWDocument::Result const &err) {
@@ -120,8 +120,9 @@ int main(int argc, char *argv[])
 
   MWAWDocument::Kind kind;
   auto confidence = MWAWDocument::MWAW_C_NONE;
-  auto input=libmwawHelper::isSupported(file, confidence, kind);
-  if (!input || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  std::shared_ptr<MWAWDocument::DetectionHandle> handle;
+  auto input=libmwawHelper::isSupported(file, confidence, kind, handle);
+  if (!input || !handle || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
@@ -131,11 +132,11 @@ int main(int argc, char *argv[])
   try {
     if (kind == MWAWDocument::MWAW_K_DRAW || kind == MWAWDocument::MWAW_K_PAINT) {
       librevenge::RVNGSVGDrawingGenerator listener(vec, "");
-      error = MWAWDocument::parse(input.get(), &listener);
+      error = MWAWDocument::parse(handle.get(), &listener);
     }
     else if (kind == MWAWDocument::MWAW_K_PRESENTATION) {
       librevenge::RVNGSVGPresentationGenerator listener(vec);
-      error = MWAWDocument::parse(input.get(), &listener);
+      error = MWAWDocument::parse(handle.get(), &listener);
     }
     else {
       fprintf(stderr,"ERROR: not a graphic/presentation document!\n");
@@ -105,8 +105,9 @@ int main(int argc, char *argv[])
 
   MWAWDocument::Kind kind;
   auto confidence = MWAWDocument::MWAW_C_NONE;
-  auto input=libmwawHelper::isSupported(file, confidence, kind);
-  if (!input || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
+  std::shared_ptr<MWAWDocument::DetectionHandle> handle;
+  auto input=libmwawHelper::isSupported(file, confidence, kind, handle);
+  if (!input || !handle || confidence != MWAWDocument::MWAW_C_EXCELLENT) {
     printf("ERROR: Unsupported file format!\n");
     return 1;
   }
@@ -122,7 +123,7 @@ int main(int argc, char *argv[])
         return 1;
       }
       librevenge::RVNGTextDrawingGenerator documentGenerator(pages);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
       if (error == MWAWDocument::MWAW_R_OK && !pages.size()) {
         printf("ERROR: find no graphics!\n");
         return 1;
@@ -131,7 +132,7 @@ int main(int argc, char *argv[])
     }
     else if (kind == MWAWDocument::MWAW_K_SPREADSHEET || kind == MWAWDocument::MWAW_K_DATABASE) {
       librevenge::RVNGTextSpreadsheetGenerator documentGenerator(pages, isInfo);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
       if (error == MWAWDocument::MWAW_R_OK && !pages.size()) {
         printf("ERROR: find no sheets!\n");
         return 1;
@@ -144,7 +145,7 @@ int main(int argc, char *argv[])
         return 1;
       }
       librevenge::RVNGTextPresentationGenerator documentGenerator(pages);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator);
       if (error == MWAWDocument::MWAW_R_OK && !pages.size()) {
         printf("ERROR: find no slides!\n");
         return 1;
@@ -153,7 +154,10 @@ int main(int argc, char *argv[])
     }
     else {
       librevenge::RVNGTextTextGenerator documentGenerator(document, isInfo);
-      error=MWAWDocument::parse(input.get(), &documentGenerator);
+      // the styles and the pictures are not needed
+      MWAWDocument::ParseOptions options;
+      options.setTextOnly(true);
+      error=MWAWDocument::parse(handle.get(), &documentGenerator, options);
     }
   }
   catch (MWAWDocument::Result const &err) {
@@ -0,0 +1,45 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// the library's internal symbols are hidden, so compile the decoder here
+#include "../lib/MWAWPackBits.cxx"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if (size < 3)
+    return 0;
+  // the first bytes define the unit size, the flags and the output size
+  int const unitSize=1+(data[0]&3);
+  int const flags=(data[0]>>2)&3;
+  std::vector<unsigned char> output(size_t(data[1])*size_t(data[2]));
+  unsigned char const *ptr=data+3, *end=data+size;
+  size_t numWritten=0;
+  libmwaw::PackBits::unpack(ptr, end, output.data(), output.size(), numWritten, unitSize, flags);
+  if (ptr<data+3 || ptr>end || numWritten>output.size())
+    abort();
+  return 0;
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -47,6 +47,7 @@
 #include "MWAWGraphicShape.hxx"
 #include "MWAWGraphicStyle.hxx"
 #include "MWAWHeader.hxx"
+#include "MWAWPackBits.hxx"
 #include "MWAWParagraph.hxx"
 #include "MWAWPictBitmap.hxx"
 #include "MWAWPictData.hxx"
@@ -112,28 +113,12 @@ struct Bitmap {
   //! creates the bitmap from the packdata
   bool unpackedData(unsigned char const *pData, int sz)
   {
-    int rPos = 0;
-    size_t wPos = m_bitmap.size(), wNPos = wPos+size_t(m_rowBytes);
-    m_bitmap.resize(size_t(wNPos));
-
-    while (rPos < sz) {
-      if (rPos+2 > sz) return false;
-      auto n = static_cast<signed char>(pData[rPos++]);
-      if (n < 0) {
-        int nCount = 1-n;
-        if (wPos+size_t(nCount) > wNPos) return false;
-
-        unsigned char val = pData[rPos++];
-        for (int i = 0; i < nCount; i++)
-          m_bitmap[wPos++] = val;
-        continue;
-      }
-      int nCount = 1+n;
-      if (rPos+nCount > sz || wPos+size_t(nCount) > wNPos) return false;
-      for (int i = 0; i < nCount; i++)
-        m_bitmap[wPos++] = pData[rPos++];
-    }
-    return (wPos == wNPos);
+    size_t wPos = m_bitmap.size();
+    m_bitmap.resize(wPos+size_t(m_rowBytes));
+    unsigned char const *pEnd=pData+sz;
+    size_t numWritten;
+    return libmwaw::PackBits::unpack(pData, pEnd, m_bitmap.data()+wPos, size_t(m_rowBytes), numWritten) &&
+           pData==pEnd && numWritten==size_t(m_rowBytes);
   }
 
   //! parses the bitmap data zone
@@ -297,30 +282,12 @@ struct Pixmap {
       MWAW_DEBUG_MSG(("ApplePictParserInternal::Pixmap::unpackedData: unknown byteSz\n"));
       return false;
     }
-    int rPos = 0, wPos = 0, maxW = m_rowBytes+24;
-    while (rPos < sz) {
-      if (rPos+2 > sz) return false;
-      auto n = static_cast<signed char>(pData[rPos++]);
-      if (n < 0) {
-        int nCount = 1-n;
-        if (rPos+byteSz > sz || wPos+byteSz *nCount >= maxW) return false;
-
-        unsigned char val[4];
-        for (int b = 0; b < byteSz; b++) val[b] = pData[rPos++];
-        for (int i = 0; i < nCount; i++) {
-          if (wPos+byteSz >= maxW) break;
-          for (int b = 0; b < byteSz; b++)res[size_t(wPos++)] = val[b];
-        }
-        continue;
-      }
-      int nCount = 1+n;
-      if (rPos+byteSz *nCount > sz || wPos+byteSz *nCount >= maxW) return false;
-      for (int i = 0; i < nCount; i++) {
-        if (wPos+byteSz >= maxW) break;
-        for (int b = 0; b < byteSz; b++) res[size_t(wPos++)] = pData[rPos++];
-      }
-    }
-    return wPos+8 >= nSize;
+    // the unpacked data must be less than m_rowBytes+24
+    if (m_rowBytes+23<=0 || res.size()<size_t(m_rowBytes+23)) return false;
+    unsigned char const *pEnd=pData+sz;
+    size_t numWritten;
+    return libmwaw::PackBits::unpack(pData, pEnd, res.data(), size_t(m_rowBytes+23), numWritten, byteSz) &&
+           pData==pEnd && int(numWritten)+8 >= nSize;
   }
 
   MWAWColor extractColor(const std::vector<unsigned char> &data, size_t rIdx, size_t gIdx, size_t bIdx)
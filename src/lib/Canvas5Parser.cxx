@@ -357,11 +357,12 @@ void Canvas5Parser::createDocument(librevenge::RVNGDrawingInterface *documentInt
     }
   }
 
-  bool first=true;
-  for (auto const &lId : listSlides) {
-    if (!first)
+  for (size_t p=0; p<listSlides.size(); ++p) {
+    if (!getParserState()->isPageSent(int(p)))
+      break;
+    if (p)
       listen->insertBreak(MWAWListener::PageBreak);
-    first=false;
+    auto const &lId=listSlides[p];
     for (auto id : lId) {
       auto const &it=m_state->m_idToSlide.find(id);
       if (it==m_state->m_idToSlide.end()) {
@@ -2777,6 +2778,20 @@ bool Canvas5Parser::checkHeader(MWAWHeader *header, bool strict)
   return true;
 }
 
+bool Canvas5Parser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr))
+    return false;
+  auto input=decode(getInput(), version());
+  if (!input)
+    return false;
+  // the summary zones are stored after the main zones, so we must read them
+  m_state->m_stream=std::make_shared<Canvas5Structure::Stream>(input);
+  createZones();
+  metaData=m_state->m_metaData;
+  return !metaData.empty();
+}
+
 // ------------------------------------------------------------
 // mac resource fork
 // ------------------------------------------------------------
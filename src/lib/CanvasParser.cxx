@@ -46,6 +46,7 @@
 #include "MWAWGraphicListener.hxx"
 #include "MWAWGraphicStyle.hxx"
 #include "MWAWHeader.hxx"
+#include "MWAWPackBits.hxx"
 #include "MWAWPosition.hxx"
 #include "MWAWPrinter.hxx"
 #include "MWAWRSRCParser.hxx"
@@ -124,35 +125,15 @@ bool Decoder::unpackBits(unsigned char const(&buffer)[256], int n,
     MWAW_DEBUG_MSG(("CanvasParserInternal::Decoder::unpackBits: bad arguments\n"));
     return false;
   }
-  int r=0;
-  n2=0;
   // canvas only packs zone with less than 127 characters
   // => we must not found <M> M+1 bits <N> N+1 bits
-  bool lastCopy=false;
-  while (r+1<n) {
-    int c=buffer[r++];
-    if (c>=0x81) {
-      unsigned char val=buffer[r++];
-      int num=0x101-c;
-      if (n2+num>256)
-        return false;
-      for (int i=0; i<num; ++i)
-        buffer2[n2++]=val;
-      lastCopy=false;
-    }
-    else {
-      // normally c==0x80 is reserved, but must not be used
-      if (lastCopy && !m_isWindows)
-        return false;
-      int num=c+1;
-      if (r+num>n || n2+num>256)
-        return false;
-      for (int i=0; i<num; ++i)
-        buffer2[n2++]=buffer[r++];
-      lastCopy=true;
-    }
-  }
-  return r==n;
+  // normally c==0x80 is reserved, but must not be used
+  unsigned char const *ptr=buffer, *end=buffer+n;
+  size_t numWritten;
+  int const flags=libmwaw::PackBits::F_Literal0x80 | (m_isWindows ? 0 : libmwaw::PackBits::F_NoConsecutiveLiterals);
+  bool ok=libmwaw::PackBits::unpack(ptr, end, buffer2, 256, numWritten, 1, flags);
+  n2=int(numWritten);
+  return ok && ptr==end;
 }
 
 bool Decoder::initOutput(MWAWInputStreamPtr &input, unsigned long const headerSize)
@@ -894,6 +875,25 @@ bool CanvasParser::checkHeader(MWAWHeader *header, bool strict)
   return true;
 }
 
+bool CanvasParser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr))
+    return false;
+  // the user names are stored in the resource fork
+  MWAWRSRCParserPtr rsrcParser = getRSRCParser();
+  if (!rsrcParser)
+    return false;
+  auto &entryMap = rsrcParser->getEntriesMap();
+  auto it = entryMap.lower_bound("USER");
+  while (it != entryMap.end() && it->first=="USER") {
+    auto const &entry=it++->second;
+    if (entry.valid())
+      readUsers(rsrcParser->getInput(), entry, rsrcParser->ascii());
+  }
+  metaData=m_state->m_metaData;
+  return !metaData.empty();
+}
+
 bool CanvasParser::readFileHeader()
 {
   auto input=getInput();
@@ -113,6 +113,13 @@ bool ClarisWksBMParser::checkHeader(MWAWHeader *header, bool strict)
   return getParserState()->m_kind==MWAWDocument::MWAW_K_PAINT;
 }
 
+bool ClarisWksBMParser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr))
+    return false;
+  return m_document->readMetaData(metaData);
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
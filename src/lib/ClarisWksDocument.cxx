@@ -265,6 +265,17 @@ librevenge::RVNGPropertyList const &ClarisWksDocument::getDocumentMetaData() con
   return m_state->m_metaData;
 }
 
+bool ClarisWksDocument::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  // the v4-v6 header contains a summary zone
+  readDocHeader();
+  long eof=-1;
+  if (m_parserState->m_version > 1)
+    readEndTable(eof, true);
+  metaData=m_state->m_metaData;
+  return !metaData.empty();
+}
+
 void ClarisWksDocument::updatePageSpanList(std::vector<MWAWPageSpan> &pageList)
 {
   MWAWPageSpan ps=getFinalPageSpan();
@@ -1457,7 +1468,7 @@ bool ClarisWksDocument::readDocHeader()
 ////////////////////////////////////////////////////////////
 // the end zone (in some v2 file and after )
 ////////////////////////////////////////////////////////////
-bool ClarisWksDocument::readEndTable(long &eof)
+bool ClarisWksDocument::readEndTable(long &eof, bool onlySummary)
 {
   MWAWInputStreamPtr input = m_parserState->m_input;
   input->seek(0, librevenge::RVNG_SEEK_END);
@@ -1515,6 +1526,8 @@ bool ClarisWksDocument::readEndTable(long &eof)
 
   for (int i = 0; i < numEntries-1; i++) {
     MWAWEntry const &entry = listEntries[size_t(i)];
+    if (onlySummary && entry.type() != "DSUM")
+      continue;
     bool parsed = false;
     if (entry.type() == "CPRT") {
       readCPRT(entry);
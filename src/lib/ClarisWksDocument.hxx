@@ -88,6 +88,8 @@ public:
 
   //! finds the different objects zones
   bool createZones();
+  //! reads the document header and the summary zones, returns the document meta data
+  bool readMetaData(librevenge::RVNGPropertyList &metaData);
 
   //! returns the document number of page
   int numPages() const;
@@ -177,8 +179,10 @@ public:
 
   // THE NAMED ENTRY
 
-  //! reads the end table ( appears in v3.0 : file version ? )
-  bool readEndTable(long &eof);
+  /** reads the end table ( appears in v3.0 : file version ? )
+
+      \note if onlySummary is set, only the summary zone is read */
+  bool readEndTable(long &eof, bool onlySummary=false);
 
   /* sequence of plist of printer : in v6 */
   bool readCPRT(MWAWEntry const &entry);
@@ -2401,7 +2401,10 @@ bool ClarisWksGraph::readOLE(ClarisWksGraphInternal::ZonePict &zone)
   libmwaw::DebugStream f;
   f << "Entries(OLE):";
   int dim[4];
-  for (auto &d : dim) d = static_cast<int>(static_cast<int32_t>(MWAWInputStream::readULong(input->input().get(), 4, 0, true)));
+  bool inverted=input->readInverted();
+  input->setReadInverted(true);
+  for (auto &d : dim) d = static_cast<int>(input->readLong(4));
+  input->setReadInverted(inverted);
   if (dim[0] >= dim[2] || dim[1] >= dim[3]) return false;
   f << "dim=" << dim[1] << "x" << dim[0] << "<->" << dim[3] << "x" << dim[2] << ",";
   zone.m_entries[1].setBegin(pos+28);
@@ -2764,6 +2767,8 @@ bool ClarisWksGraph::sendPageChild(ClarisWksGraphInternal::Group &group)
 
   for (auto child : group.m_zonesToSend) {
     if (!child || child->m_page<=0) continue;
+    // the pages are numbered from 1, see MWAWDocument::ParseOptions::setMaxPages
+    if (!m_parserState->isPageSent(child->m_page-1)) continue;
     if (child->getType() == ClarisWksGraphInternal::Zone::T_Zone) {
       auto dset=m_document.getZone(child->getZoneId());
       if (dset && dset->m_position==ClarisWksStruct::DSET::P_Main)
@@ -3277,6 +3282,8 @@ bool ClarisWksGraph::sendBitmap(ClarisWksGraphInternal::Bitmap &bitmap, MWAWList
 
 bool ClarisWksGraph::sendPicture(ClarisWksGraphInternal::ZonePict &pict, MWAWPosition pos)
 {
+  // text only mode: do not decode the picture
+  if (m_parserState->m_textOnly) return true;
   bool send = false;
   bool posOk = pos.size()[0] > 0 && pos.size()[1] > 0;
   MWAWInputStreamPtr &input= m_parserState->m_input;
@@ -173,6 +173,13 @@ bool ClarisWksPRParser::checkHeader(MWAWHeader *header, bool strict)
   return getParserState()->m_kind==MWAWDocument::MWAW_K_PRESENTATION;
 }
 
+bool ClarisWksPRParser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr))
+    return false;
+  return m_document->readMetaData(metaData);
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -202,6 +202,13 @@ bool ClarisWksParser::checkHeader(MWAWHeader *header, bool strict)
          getParserState()->m_kind==MWAWDocument::MWAW_K_DRAW;
 }
 
+bool ClarisWksParser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr))
+    return false;
+  return m_document->readMetaData(metaData);
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -220,7 +227,7 @@ void ClarisWksParser::parse(librevenge::RVNGTextInterface *docInterface)
       createDocument(docInterface);
       auto const &mainZonesList=m_document->getMainZonesList();
       if (getParserState()->m_kind==MWAWDocument::MWAW_K_DRAW) {
-        for (int i=0; i<m_state->m_numPages; ++i)
+        for (int i=0; i<m_state->m_numPages && getParserState()->isPageSent(i); ++i)
           m_document->getGraphParser()->sendMaster(i);
       }
       for (auto const zone : mainZonesList)
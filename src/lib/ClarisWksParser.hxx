@@ -77,6 +77,8 @@ public:
 
   //! checks if the document header is correct (or not)
   bool checkHeader(MWAWHeader *header, bool strict=false) final;
+  //! reads the header and the summary zones to retrieve the document meta data
+  bool readMetaData(librevenge::RVNGPropertyList &metaData) final;
 
   // the main parse function
   void parse(librevenge::RVNGTextInterface *documentInterface) final;
@@ -182,6 +182,13 @@ bool ClarisWksSSParser::checkHeader(MWAWHeader *header, bool strict)
          getParserState()->m_kind==MWAWDocument::MWAW_K_DATABASE;
 }
 
+bool ClarisWksSSParser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr))
+    return false;
+  return m_document->readMetaData(metaData);
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -1760,12 +1761,40 @@ bool ClarisWksText::sendText(ClarisWksTextInternal::Zone const &zone, MWAWListen
         break;
 
       default: {
-        int extraChar = listener->insertCharacter
-                        (static_cast<unsigned char>(c), input, input->tell()+(numC-1-i));
-        if (extraChar) {
-          i += extraChar;
-          actC += extraChar;
+        long actPos=input->tell();
+        unsigned long numRead=0;
+        uint8_t const *data=nullptr;
+        if (static_cast<unsigned char>(c) >= 0x20) {
+          // the run must stop before the next plc and the next section
+          auto maxRun=long(numC-i);
+          auto nextPlcIt=zone.m_plcMap.lower_bound(actC);
+          if (nextPlcIt!=zone.m_plcMap.end())
+            maxRun=std::min(maxRun, std::max(long(1), nextPlcIt->first-actC+1));
+          if (nextSectionPos>=0)
+            maxRun=std::min(maxRun, std::max(long(1), nextSectionPos-actC+1));
+          input->seek(actPos-1, librevenge::RVNG_SEEK_SET);
+          data=input->read(size_t(maxRun), numRead);
         }
+        if (!data || !numRead) {
+          input->seek(actPos, librevenge::RVNG_SEEK_SET);
+          int extraChar = listener->insertCharacter
+                          (static_cast<unsigned char>(c), input, input->tell()+(numC-1-i));
+          if (extraChar) {
+            i += extraChar;
+            actC += extraChar;
+          }
+          break;
+        }
+        // send the following characters which are not special characters
+        auto numRun=long(1);
+        while (numRun < long(numRead) && data[numRun] >= 0x20)
+          ++numRun;
+        listener->insertCharacters(data, size_t(numRun));
+        if (numRun>1)
+          f << std::string(reinterpret_cast<char const *>(data+1), size_t(numRun-1));
+        input->seek(actPos-1+numRun, librevenge::RVNG_SEEK_SET);
+        i += int(numRun-1);
+        actC += numRun-1;
       }
       }
     }
@@ -0,0 +1,244 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "libmwaw_internal.hxx"
+
+#include "MWAWBinHexStream.hxx"
+
+namespace MWAWBinHexStreamInternal
+{
+//! the size of a block of decoded data
+static long const s_blockSize=0x10000;
+//! returns the value corresponding to a BinHex character or -1
+static int getBinValue(unsigned char c)
+{
+  static int const *table=[]() {
+    static int values[256];
+    for (auto &val : values) val=-1;
+    static char const binChar[65] = "!\"#$%&'()*+,-012345689@ABCDEFGHIJKLMNPQRSTUVXYZ[`abcdefhijklmpqr";
+    for (int i = 0; i < 64; i++) values[static_cast<unsigned char>(binChar[i])]=i;
+    return values;
+  }();
+  return table[c];
+}
+}
+
+MWAWBinHexStream::MWAWBinHexStream(std::shared_ptr<librevenge::RVNGInputStream> const &input, long begin)
+  : librevenge::RVNGInputStream()
+  , m_input(input)
+  , m_inputPos(begin)
+  , m_blocks()
+  , m_dataSize(0)
+  , m_readBuffer()
+  , m_decodedSize(-1)
+  , m_offset(0)
+  , m_numActBits(0)
+  , m_actVal(0)
+  , m_findRepetitif(false)
+  , m_decodingEnded(!input)
+{
+}
+
+MWAWBinHexStream::~MWAWBinHexStream()
+{
+}
+
+long MWAWBinHexStream::size()
+{
+  if (m_decodedSize>=0)
+    return m_decodedSize;
+  decode(std::numeric_limits<long>::max());
+  return m_dataSize;
+}
+
+bool MWAWBinHexStream::decode(long numBytes)
+{
+  static unsigned long const blockSize=0x1000;
+  while (m_dataSize<numBytes && !m_decodingEnded) {
+    unsigned long numRead=0;
+    unsigned char const *encoded=nullptr;
+    if (m_input->seek(m_inputPos, librevenge::RVNG_SEEK_SET)==0)
+      encoded=m_input->read(blockSize, numRead);
+    if (!encoded || numRead==0) {
+      MWAW_DEBUG_MSG(("MWAWBinHexStream::decode: do not find ending ':' character\n"));
+      m_decodingEnded=true;
+      break;
+    }
+    m_inputPos+=long(numRead);
+    for (unsigned long i=0; i<numRead && !m_decodingEnded; ++i)
+      decode(encoded[i]);
+  }
+  return m_dataSize>=numBytes;
+}
+
+void MWAWBinHexStream::append(unsigned char c)
+{
+  long const blockSize=MWAWBinHexStreamInternal::s_blockSize;
+  if (m_dataSize==long(m_blocks.size())*blockSize)
+    m_blocks.push_back(std::unique_ptr<unsigned char[]>(new unsigned char[size_t(blockSize)]));
+  m_blocks.back()[size_t(m_dataSize%blockSize)]=c;
+  ++m_dataSize;
+}
+
+void MWAWBinHexStream::decode(unsigned char c)
+{
+  if (c == '\n') return;
+  bool endData = false;
+  int readVal = 0;
+  if (c == ':')
+    endData = true;
+  else {
+    readVal = MWAWBinHexStreamInternal::getBinValue(c);
+    if (readVal < 0) {
+      MWAW_DEBUG_MSG(("MWAWBinHexStream::decode: find unexpected char when decoding file\n"));
+      m_decodingEnded = true;
+      return;
+    }
+  }
+  int wVal = -1;
+  if (m_numActBits==0)
+    m_actVal |= (readVal<<2);
+  else if (m_numActBits==2) {
+    wVal = (m_actVal | readVal);
+    m_actVal = 0;
+  }
+  else if (m_numActBits==4) {
+    wVal = m_actVal | ((readVal>>2)&0xF);
+    m_actVal = (readVal&0x3)<<6;
+  }
+  else if (m_numActBits==6) {
+    wVal = m_actVal | ((readVal>>4)&0x3);
+    m_actVal = (readVal&0xf)<<4;
+  }
+  m_numActBits = (m_numActBits+6)%8;
+
+  int maxToWrite = (endData&&m_actVal) ? 2 : 1;
+  for (int wPos = 0; wPos < maxToWrite; wPos++) {
+    int value = wPos ? m_actVal : wVal;
+    if (value == -1) continue;
+    if (!m_findRepetitif && value != 0x90) {
+      append(static_cast<unsigned char>(value));
+      continue;
+    }
+    if (value == 0x90 && !m_findRepetitif) {
+      m_findRepetitif = true;
+      continue;
+    }
+
+    if (value == 1 || value == 2) {
+      MWAW_DEBUG_MSG(("MWAWBinHexStream::decode: find bad value after repetitif character\n"));
+      m_decodingEnded = true;
+      return;
+    }
+    m_findRepetitif = false;
+    if (value == 0) {
+      append(0x90);
+      continue;
+    }
+    if (m_dataSize==0) {
+      MWAW_DEBUG_MSG(("MWAWBinHexStream::decode: find repetitif character in the first position\n"));
+      m_decodingEnded = true;
+      return;
+    }
+    long const blockSize=MWAWBinHexStreamInternal::s_blockSize;
+    unsigned char lChar = m_blocks.back()[size_t((m_dataSize-1)%blockSize)];
+    for (int i=1; i<value; ++i)
+      append(lChar);
+  }
+  if (endData) {
+    if (m_findRepetitif) {
+      MWAW_DEBUG_MSG(("MWAWBinHexStream::decode: find repetitif character in the last position\n"));
+    }
+    m_decodingEnded = true;
+  }
+}
+
+const unsigned char *MWAWBinHexStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+  numBytesRead = 0;
+  if (numBytes == 0 || m_offset < 0)
+    return nullptr;
+  long endPos = m_offset+long(numBytes);
+  if (m_decodedSize >= 0 && endPos > m_decodedSize)
+    endPos = m_decodedSize;
+  decode(endPos);
+  if (endPos > m_dataSize)
+    endPos = m_dataSize;
+  if (endPos <= m_offset)
+    return nullptr;
+  numBytesRead = static_cast<unsigned long>(endPos-m_offset);
+  long const blockSize=MWAWBinHexStreamInternal::s_blockSize;
+  size_t block=size_t(m_offset/blockSize);
+  long blockPos=m_offset%blockSize;
+  unsigned char const *res = m_blocks[block].get()+blockPos;
+  if (blockPos+long(numBytesRead) > blockSize) {
+    // the data are stored in several blocks, copy them
+    m_readBuffer.resize(size_t(numBytesRead));
+    for (size_t w=0; w<size_t(numBytesRead); ++block) {
+      size_t const n=std::min(size_t(numBytesRead)-w, size_t(blockSize-blockPos));
+      std::memcpy(m_readBuffer.data()+w, m_blocks[block].get()+blockPos, n);
+      w+=n;
+      blockPos=0;
+    }
+    res=m_readBuffer.data();
+  }
+  m_offset = endPos;
+  return res;
+}
+
+int MWAWBinHexStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+{
+  if (seekType == librevenge::RVNG_SEEK_CUR)
+    m_offset += offset;
+  else if (seekType == librevenge::RVNG_SEEK_SET)
+    m_offset = offset;
+  else if (seekType == librevenge::RVNG_SEEK_END)
+    m_offset = offset+size();
+
+  if (m_offset < 0) {
+    m_offset = 0;
+    return -1;
+  }
+  long maxSize = m_decodedSize;
+  if (maxSize < 0) // only decode the data until offset
+    maxSize = decode(m_offset) ? m_offset : m_dataSize;
+  if (m_offset > maxSize) {
+    m_offset = maxSize;
+    return -1;
+  }
+
+  return 0;
+}
+
+bool MWAWBinHexStream::isEnd()
+{
+  if (m_decodedSize >= 0)
+    return m_offset >= m_decodedSize;
+  return !decode(m_offset+1);
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,164 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#ifndef MWAW_BINHEX_STREAM_HXX
+#define MWAW_BINHEX_STREAM_HXX
+
+#include <memory>
+#include <vector>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+/** internal class used to read a BinHex 4.0 encoded input
+
+    The data are decoded on demand, when the stream is read, so
+    reading the beginning of a big file only requires to decode a few
+    kilobytes. The decoded data are kept in memory, in blocks which are
+    never moved, so seeking back does not require to decode the data
+    again and the decoding of new data does not invalidate the pointers
+    returned by read.
+
+    \note the stream begins at the first byte of the BinHex content,
+    ie. its header, so the data and resource forks must be retrieved
+    using MWAWInputStream::slice
+ */
+class MWAWBinHexStream final : public librevenge::RVNGInputStream
+{
+public:
+  //! constructor: begin is the position of the first encoded character (after the ':')
+  MWAWBinHexStream(std::shared_ptr<librevenge::RVNGInputStream> const &input, long begin);
+  //! destructor
+  ~MWAWBinHexStream() final;
+
+  /** sets the size of the decoded data (as given by the BinHex header)
+
+      \note if the size is not set, seeking to the end of the stream
+      requires to decode all the data */
+  void setDecodedSize(long size)
+  {
+    m_decodedSize=size;
+  }
+
+  /**! reads numbytes data.
+
+   * \return a pointer to the read elements
+
+   \note if the data are stored in two blocks, they are copied in a
+   buffer which remains valid until the next read of data overlapping
+   two blocks
+   */
+  const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead) final;
+  //! returns actual offset position
+  long tell() final
+  {
+    return m_offset;
+  }
+  /*! \brief seeks to a offset position, from actual, beginning or ending position
+   * \return 0 if ok
+   */
+  int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType) final;
+  //! returns true if we are at the end of the section/file
+  bool isEnd() final;
+
+  /** returns true if the stream is ole
+
+   \sa returns always false*/
+  bool isStructured() final
+  {
+    return false;
+  }
+  /** returns the number of sub streams.
+
+   \sa returns always 0*/
+  unsigned subStreamCount() final
+  {
+    return 0;
+  }
+  /** returns the ith sub streams name
+
+   \sa returns always 0*/
+  const char *subStreamName(unsigned) final
+  {
+    return nullptr;
+  }
+  /** returns true if a substream with name exists
+
+   \sa returns always false*/
+  bool existsSubStream(const char *) final
+  {
+    return false;
+  }
+  /** return a new stream for a ole zone
+
+   \sa returns always 0 */
+  librevenge::RVNGInputStream *getSubStreamByName(const char *) final
+  {
+    return nullptr;
+  }
+  /** return a new stream for a ole zone
+
+   \sa returns always 0 */
+  librevenge::RVNGInputStream *getSubStreamById(unsigned) final
+  {
+    return nullptr;
+  }
+
+protected:
+  //! returns the stream size: the decoded size if it is known or the size of all the decodable data
+  long size();
+  //! tries to decode the data until the decoded data contains at least numBytes bytes
+  bool decode(long numBytes);
+  //! decodes a encoded character
+  void decode(unsigned char c);
+  //! appends a decoded byte
+  void append(unsigned char c);
+
+private:
+  //! the encoded input
+  std::shared_ptr<librevenge::RVNGInputStream> m_input;
+  //! the position of the next character to decode in m_input
+  long m_inputPos;
+  //! the decoded data: blocks of 64 kilobytes
+  std::vector<std::unique_ptr<unsigned char[]> > m_blocks;
+  //! the number of decoded bytes
+  long m_dataSize;
+  //! a buffer used to return the data stored in two blocks
+  std::vector<unsigned char> m_readBuffer;
+  //! the decoded size if known or -1
+  long m_decodedSize;
+  //! the stream offset
+  long m_offset;
+  //! the number of bits of the current byte which have been decoded
+  int m_numActBits;
+  //! the current byte bits
+  int m_actVal;
+  //! a flag to know if we have read the RLE marker 0x90
+  bool m_findRepetitif;
+  //! a flag to know if the decoding is finished (or if an error has been found)
+  bool m_decodingEnded;
+
+  MWAWBinHexStream(const MWAWBinHexStream &) = delete; // copy is not allowed
+  MWAWBinHexStream &operator=(const MWAWBinHexStream &) = delete; // assignment is not allowed
+};
+
+#endif
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
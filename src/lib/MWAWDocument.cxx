@@ -35,9 +35,16 @@
  * libmwaw API: implementation of main interface functions
  */
 
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
 #include "MWAWHeader.hxx"
 #include "MWAWGraphicDecoder.hxx"
+#include "MWAWMappedStream.hxx"
 #include "MWAWParser.hxx"
+#include "MWAWPictBitmap.hxx"
 #include "MWAWPropertyHandler.hxx"
 #include "MWAWRSRCParser.hxx"
 #include "MWAWSpreadsheetDecoder.hxx"
@@ -126,33 +133,112 @@ std::shared_ptr<MWAWSpreadsheetParser> getSpreadsheetParserFromHeader(MWAWInputS
 std::shared_ptr<MWAWTextParser> getTextParserFromHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr const &rsrcParser, MWAWHeader *header);
 MWAWHeader *getHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr const &rsrcParser, bool strict);
 bool checkBasicMacHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr const &rsrcParser, MWAWHeader &header, bool strict);
+int checkHeadersInParallel(std::vector<MWAWInputStreamPtr> &inputs, std::vector<MWAWRSRCParserPtr> const &rsrcParsers,
+                           std::vector<MWAWHeader> &headers, bool strict, int numThreads);
+
+//! the maximum number of threads used to check the candidate headers
+static std::atomic<int> s_numDetectionThreads(1);
+/** the minimal size of a file (data and resource forks) whose
+    candidate headers are checked in parallel.
+
+    Checking a candidate only reads the beginning of the main zones, so
+    for a small file, creating the threads, the input copies and the
+    resource parsers costs more than checking the candidates one by
+    one. */
+static long const s_minParallelDetectionSize=1024*1024;
+
+//! sets the parse options in the parser state and parses the document
+template <class Parser, class Interface>
+void parse(Parser &parser, Interface *documentInterface, MWAWDocument::ParseOptions const &options)
+{
+  MWAWParserStatePtr state=parser.getParserState();
+  state->m_textOnly=options.isTextOnly();
+  state->m_maxPages=options.getMaxPages();
+  state->m_rawBitmaps=options.useRawBitmaps();
+  state->m_parseOptions=options;
+  try {
+    parser.parse(documentInterface);
+  }
+  catch (libmwaw::ParseException) {
+    // the listeners stop the parsing once the last requested page is sent
+    if (!state->m_maxPagesReached)
+      throw;
+  }
+}
 }
 
+/** the class used to store the result of a file format detection */
+class MWAWDocument::DetectionHandle
+{
+public:
+  //! constructor: unwraps the input and creates the resource parser
+  explicit DetectionHandle(librevenge::RVNGInputStream *input)
+    : m_input(new MWAWInputStream(input, false, true))
+    , m_rsrcParser()
+    , m_header()
+    , m_rsrcParsed(false)
+  {
+    MWAWInputStreamPtr rsrc=m_input->getResourceForkStream();
+    if (rsrc) {
+      m_rsrcParser.reset(new MWAWRSRCParser(rsrc));
+      m_rsrcParser->setAsciiName("RSRC");
+    }
+  }
+  //! tries to find the file header, returns true if a header is found
+  bool detect(bool strict)
+  {
+    m_header.reset(MWAWDocumentInternal::getHeader(m_input, m_rsrcParser, strict));
+    return bool(m_header);
+  }
+  //! parses the resource fork if it exists and if this is not already done
+  void parseResourceFork()
+  {
+    if (m_rsrcParsed) return;
+    m_rsrcParsed=true;
+    if (m_rsrcParser)
+      m_rsrcParser->parse();
+  }
+  //! the unwrapped input
+  MWAWInputStreamPtr m_input;
+  //! the resource parser
+  MWAWRSRCParserPtr m_rsrcParser;
+  //! the header
+  std::shared_ptr<MWAWHeader> m_header;
+  //! a flag to know if the resource fork has been parsed
+  bool m_rsrcParsed;
+private:
+  DetectionHandle(DetectionHandle const &orig) = delete;
+  DetectionHandle &operator=(DetectionHandle const &orig) = delete;
+};
+
 MWAWDocument::Confidence MWAWDocument::isFileFormatSupported(librevenge::RVNGInputStream *input,  MWAWDocument::Type &type, Kind &kind)
+{
+  DetectionHandle *handle=nullptr;
+  Confidence confidence=isFileFormatSupported(input, type, kind, handle);
+  releaseDetectionHandle(handle);
+  return confidence;
+}
+
+MWAWDocument::Confidence MWAWDocument::isFileFormatSupported(librevenge::RVNGInputStream *input,  MWAWDocument::Type &type, Kind &kind, DetectionHandle *&handle)
 try
 {
   type = MWAW_T_UNKNOWN;
   kind = MWAW_K_UNKNOWN;
+  handle = nullptr;
 
   if (!input) {
     MWAW_DEBUG_MSG(("MWAWDocument::isFileFormatSupported(): no input\n"));
     return MWAW_C_NONE;
   }
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  std::shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc)
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-  std::shared_ptr<MWAWHeader> header;
+  std::unique_ptr<DetectionHandle> detection(new DetectionHandle(input));
 #ifdef DEBUG
-  header.reset(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  if (!detection->detect(false))
 #else
-  header.reset(MWAWDocumentInternal::getHeader(ip, rsrcParser, true));
+  if (!detection->detect(true))
 #endif
-
-  if (!header.get())
     return MWAW_C_NONE;
+  std::shared_ptr<MWAWHeader> header=detection->m_header;
   type = static_cast<MWAWDocument::Type>(header->getType());
   kind = static_cast<MWAWDocument::Kind>(header->getKind());
   Confidence confidence = MWAW_C_NONE;
@@ -251,6 +337,8 @@ try
     break;
   }
 
+  if (confidence != MWAW_C_NONE)
+    handle = detection.release();
   return confidence;
 }
 catch (...)
@@ -258,30 +346,206 @@ catch (...)
   MWAW_DEBUG_MSG(("MWAWDocument::isFileFormatSupported: exception catched\n"));
   type = MWAW_T_UNKNOWN;
   kind = MWAW_K_UNKNOWN;
+  handle = nullptr;
   return MWAW_C_NONE;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *)
+void MWAWDocument::releaseDetectionHandle(DetectionHandle *handle)
+{
+  delete handle;
+}
+
+void MWAWDocument::setNumDetectionThreads(int numThreads)
+{
+  MWAWDocumentInternal::s_numDetectionThreads=numThreads>1 ? numThreads : 1;
+}
+
+/** the storage of the parse options */
+struct MWAWDocument::ParseOptions::Data {
+  //! constructor
+  Data()
+    : m_textOnly(false)
+    , m_maxPages(0)
+    , m_rawBitmaps(false)
+    , m_pngCompressionLevel(3)
+    , m_pngStrategy(PNG_Default)
+    , m_pngAdaptiveFiltering(false)
+    , m_pngNumThreads(1)
+  {
+  }
+  //! a flag to only retrieve the text
+  bool m_textOnly;
+  //! the maximum number of pages to send, 0 means all
+  int m_maxPages;
+  //! a flag to send the bitmaps without encoding them
+  bool m_rawBitmaps;
+  //! the PNG deflate compression level
+  int m_pngCompressionLevel;
+  //! the PNG deflate strategy
+  PNGStrategy m_pngStrategy;
+  //! a flag to filter the rows of the true color bitmaps
+  bool m_pngAdaptiveFiltering;
+  //! the maximum number of threads used to compress a bitmap
+  int m_pngNumThreads;
+};
+
+MWAWDocument::ParseOptions::ParseOptions()
+  : m_data(new Data)
+{
+}
+
+MWAWDocument::ParseOptions::ParseOptions(ParseOptions const &orig)
+  : m_data(new Data(*orig.m_data))
+{
+}
+
+MWAWDocument::ParseOptions &MWAWDocument::ParseOptions::operator=(ParseOptions const &orig)
+{
+  if (this!=&orig)
+    *m_data=*orig.m_data;
+  return *this;
+}
+
+MWAWDocument::ParseOptions::~ParseOptions()
+{
+  delete m_data;
+}
+
+void MWAWDocument::ParseOptions::setTextOnly(bool textOnly)
+{
+  m_data->m_textOnly=textOnly;
+}
+
+bool MWAWDocument::ParseOptions::isTextOnly() const
+{
+  return m_data->m_textOnly;
+}
+
+void MWAWDocument::ParseOptions::setMaxPages(int maxPages)
+{
+  m_data->m_maxPages=maxPages>0 ? maxPages : 0;
+}
+
+int MWAWDocument::ParseOptions::getMaxPages() const
+{
+  return m_data->m_maxPages;
+}
+
+void MWAWDocument::ParseOptions::setRawBitmaps(bool rawBitmaps)
+{
+  m_data->m_rawBitmaps=rawBitmaps;
+}
+
+bool MWAWDocument::ParseOptions::useRawBitmaps() const
+{
+  return m_data->m_rawBitmaps;
+}
+
+void MWAWDocument::ParseOptions::setPNGCompressionLevel(int level)
+{
+  m_data->m_pngCompressionLevel=std::max(-1, std::min(9, level));
+}
+
+int MWAWDocument::ParseOptions::getPNGCompressionLevel() const
+{
+  return m_data->m_pngCompressionLevel;
+}
+
+void MWAWDocument::ParseOptions::setPNGStrategy(PNGStrategy strategy)
+{
+  m_data->m_pngStrategy=strategy;
+}
+
+MWAWDocument::ParseOptions::PNGStrategy MWAWDocument::ParseOptions::getPNGStrategy() const
+{
+  return m_data->m_pngStrategy;
+}
+
+void MWAWDocument::ParseOptions::setPNGAdaptiveFiltering(bool adaptiveFiltering)
+{
+  m_data->m_pngAdaptiveFiltering=adaptiveFiltering;
+}
+
+bool MWAWDocument::ParseOptions::usePNGAdaptiveFiltering() const
+{
+  return m_data->m_pngAdaptiveFiltering;
+}
+
+void MWAWDocument::ParseOptions::setPNGNumThreads(int numThreads)
+{
+  m_data->m_pngNumThreads=numThreads>1 ? numThreads : 1;
+}
+
+int MWAWDocument::ParseOptions::getPNGNumThreads() const
+{
+  return m_data->m_pngNumThreads;
+}
+
+librevenge::RVNGInputStream *MWAWDocument::createMappedFileStream(char const *fileName)
+try
+{
+  if (!fileName) {
+    MWAW_DEBUG_MSG(("MWAWDocument::createMappedFileStream(): called without file name\n"));
+    return nullptr;
+  }
+  std::unique_ptr<MWAWMappedStream> res(new MWAWMappedStream(fileName));
+  if (!res->isValid() || res->isStructuredFile())
+    return nullptr;
+  return res.release();
+}
+catch (...)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::createMappedFileStream: exception catched\n"));
+  return nullptr;
+}
+
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  std::shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  std::shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  DetectionHandle handle(input);
+  if (!handle.detect(false)) return MWAW_R_UNKNOWN_ERROR;
+  return parse(&handle, documentInterface, options, password);
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: File exception trapped\n"));
+  return MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Parse exception trapped\n"));
+  return MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Unknown exception trapped\n"));
+  return MWAW_R_UNKNOWN_ERROR;
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
+{
+  return parse(handle, documentInterface, ParseOptions(), password);
+}
+
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options, char const *)
+try
+{
+  if (!handle || !handle->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  auto parser=MWAWDocumentInternal::getGraphicParserFromHeader(ip, rsrcParser, header.get());
+  handle->parseResourceFork();
+  auto parser=MWAWDocumentInternal::getGraphicParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  MWAWDocumentInternal::parse(*parser, documentInterface, options);
 
   return MWAW_R_OK;
 }
@@ -302,27 +566,53 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *)
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  std::shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  std::shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  DetectionHandle handle(input);
+  if (!handle.detect(false)) return MWAW_R_UNKNOWN_ERROR;
+  return parse(&handle, documentInterface, options, password);
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: File exception trapped\n"));
+  return MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Parse exception trapped\n"));
+  return MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Unknown exception trapped\n"));
+  return MWAW_R_UNKNOWN_ERROR;
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
+{
+  return parse(handle, documentInterface, ParseOptions(), password);
+}
+
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options, char const *)
+try
+{
+  if (!handle || !handle->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  auto parser=MWAWDocumentInternal::getPresentationParserFromHeader(ip, rsrcParser, header.get());
+  handle->parseResourceFork();
+  auto parser=MWAWDocumentInternal::getPresentationParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  MWAWDocumentInternal::parse(*parser, documentInterface, options);
 
   return MWAW_R_OK;
 }
@@ -343,25 +633,41 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *)
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password)
 try
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  std::shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  std::shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  DetectionHandle handle(input);
+  if (!handle.detect(false)) return MWAW_R_UNKNOWN_ERROR;
+  return parse(&handle, documentInterface, password);
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: File exception trapped\n"));
+  return MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Parse exception trapped\n"));
+  return MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Unknown exception trapped\n"));
+  return MWAW_R_UNKNOWN_ERROR;
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *)
+try
+{
+  if (!handle || !handle->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  auto parser=MWAWDocumentInternal::getSpreadsheetParserFromHeader(ip, rsrcParser, header.get());
+  handle->parseResourceFork();
+  auto parser=MWAWDocumentInternal::getSpreadsheetParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
   parser->parse(documentInterface);
 
@@ -384,27 +690,53 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
-MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const * /*password*/)
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+MWAWDocument::Result MWAWDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return MWAW_R_UNKNOWN_ERROR;
 
-  MWAWInputStreamPtr ip(new MWAWInputStream(input, false, true));
-  MWAWInputStreamPtr rsrc=ip->getResourceForkStream();
-  std::shared_ptr<MWAWRSRCParser> rsrcParser;
-  if (rsrc) {
-    rsrcParser.reset(new MWAWRSRCParser(rsrc));
-    rsrcParser->setAsciiName("RSRC");
-    rsrcParser->parse();
-  }
-  std::shared_ptr<MWAWHeader> header(MWAWDocumentInternal::getHeader(ip, rsrcParser, false));
+  DetectionHandle handle(input);
+  if (!handle.detect(false)) return MWAW_R_UNKNOWN_ERROR;
+  return parse(&handle, documentInterface, options, password);
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: File exception trapped\n"));
+  return MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Parse exception trapped\n"));
+  return MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocument::parse: Unknown exception trapped\n"));
+  return MWAW_R_UNKNOWN_ERROR;
+}
+
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGTextInterface *documentInterface, char const *password)
+{
+  return parse(handle, documentInterface, ParseOptions(), password);
+}
 
-  if (!header.get()) return MWAW_R_UNKNOWN_ERROR;
+MWAWDocument::Result MWAWDocument::parse(DetectionHandle *handle, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options, char const *)
+try
+{
+  if (!handle || !handle->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
 
-  auto parser=MWAWDocumentInternal::getTextParserFromHeader(ip, rsrcParser, header.get());
+  handle->parseResourceFork();
+  auto parser=MWAWDocumentInternal::getTextParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
   if (!parser) return MWAW_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  MWAWDocumentInternal::parse(*parser, documentInterface, options);
 
   return MWAW_R_OK;
 }
@@ -425,6 +757,73 @@ catch (...)
   return MWAW_R_UNKNOWN_ERROR;
 }
 
+MWAWDocument::Result MWAWDocument::getMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData)
+try
+{
+  metaData.clear();
+  if (!input)
+    return MWAW_R_UNKNOWN_ERROR;
+
+  DetectionHandle handle(input);
+  if (!handle.detect(false)) return MWAW_R_UNKNOWN_ERROR;
+  return getMetaData(&handle, metaData);
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::getMetaData: File exception trapped\n"));
+  return MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::getMetaData: Parse exception trapped\n"));
+  return MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocument::getMetaData: Unknown exception trapped\n"));
+  return MWAW_R_UNKNOWN_ERROR;
+}
+
+MWAWDocument::Result MWAWDocument::getMetaData(DetectionHandle *handle, librevenge::RVNGPropertyList &metaData)
+try
+{
+  metaData.clear();
+  if (!handle || !handle->m_header)
+    return MWAW_R_UNKNOWN_ERROR;
+
+  handle->parseResourceFork();
+  // each get*ParserFromHeader only accepts the kinds it can parse
+  std::shared_ptr<MWAWParser> parser=MWAWDocumentInternal::getGraphicParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
+  if (!parser)
+    parser=MWAWDocumentInternal::getPresentationParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
+  if (!parser)
+    parser=MWAWDocumentInternal::getSpreadsheetParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
+  if (!parser)
+    parser=MWAWDocumentInternal::getTextParserFromHeader(handle->m_input, handle->m_rsrcParser, handle->m_header.get());
+  if (!parser) return MWAW_R_UNKNOWN_ERROR;
+  if (!parser->readMetaData(metaData))
+    metaData.clear();
+
+  return MWAW_R_OK;
+}
+catch (libmwaw::FileException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::getMetaData: File exception trapped\n"));
+  return MWAW_R_FILE_ACCESS_ERROR;
+}
+catch (libmwaw::ParseException)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::getMetaData: Parse exception trapped\n"));
+  return MWAW_R_PARSE_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  MWAW_DEBUG_MSG(("MWAWDocument::getMetaData: Unknown exception trapped\n"));
+  return MWAW_R_UNKNOWN_ERROR;
+}
+
 bool MWAWDocument::decodeGraphic(librevenge::RVNGBinaryData const &binary, librevenge::RVNGDrawingInterface *paintInterface)
 try
 {
@@ -465,6 +864,26 @@ bool MWAWDocument::decodeText(librevenge::RVNGBinaryData const &, librevenge::RV
   return false;
 }
 
+bool MWAWDocument::decodeBitmap(librevenge::RVNGBinaryData const &binary, librevenge::RVNGBinaryData &result)
+{
+  return decodeBitmap(binary, result, ParseOptions());
+}
+
+bool MWAWDocument::decodeBitmap(librevenge::RVNGBinaryData const &binary, librevenge::RVNGBinaryData &result, ParseOptions const &options)
+try
+{
+  if (!binary.size()) {
+    MWAW_DEBUG_MSG(("MWAWDocument::decodeBitmap: called with no data\n"));
+    return false;
+  }
+  return MWAWPictBitmap::decodeRawData(binary, result, options);
+}
+catch (...)
+{
+  MWAW_DEBUG_MSG(("MWAWDocument::decodeBitmap: unknown error\n"));
+  return false;
+}
+
 namespace MWAWDocumentInternal
 {
 /** return the header corresponding to an input. Or 0L if no input are found */
@@ -491,6 +910,38 @@ try
   size_t numHeaders = listHeaders.size();
   if (numHeaders==0) return nullptr;
 
+  int numThreads=s_numDetectionThreads;
+  long fileSize=0;
+  if (numThreads>1 && numHeaders>1 && ip->isMemoryMapped()) {
+    fileSize=ip->size();
+    if (ip->hasResourceFork())
+      fileSize+=ip->getResourceForkStream()->size();
+  }
+  if (fileSize>=s_minParallelDetectionSize) {
+    // each candidate is checked on its own copy of the input
+    std::vector<MWAWInputStreamPtr> inputs;
+    std::vector<MWAWRSRCParserPtr> rsrcParsers;
+    for (size_t i = 0; i < numHeaders; i++) {
+      auto input=ip->copyCursor();
+      if (!input) break;
+      MWAWRSRCParserPtr parser;
+      if (rsrcParser) {
+        parser.reset(new MWAWRSRCParser(input->getResourceForkStream()));
+        parser->setAsciiName("RSRC");
+      }
+      inputs.push_back(input);
+      rsrcParsers.push_back(parser);
+    }
+    if (inputs.size()==numHeaders) {
+      for (int step=0; step<2; ++step) {
+        int id=checkHeadersInParallel(inputs, rsrcParsers, listHeaders, step==0, numThreads);
+        if (id>=0)
+          return new MWAWHeader(listHeaders[size_t(id)]);
+        if (strict) break;
+      }
+      return nullptr;
+    }
+  }
   for (int step=0; step<2; ++step) {
     for (size_t i = 0; i < numHeaders; i++) {
       if (!MWAWDocumentInternal::checkBasicMacHeader(ip, rsrcParser, listHeaders[i], step==0))
@@ -1112,6 +1563,55 @@ std::shared_ptr<MWAWTextParser> getTextParserFromHeader(MWAWInputStreamPtr &inpu
   return parser;
 }
 
+/** checks the candidate headers simultaneously using at most numThreads
+    threads, each header being checked with its own input and resource
+    parser. Returns the index of the first valid header or -1.
+
+    \note the parsers created by checkBasicMacHeader only share some
+    static data between the threads: the font converters' conversion
+    tables, the BinHex decoding table and the header signature tables,
+    which are built once (function local statics) and then only read.
+    The checkHeader functions and the functions they call must not
+    modify a static variable: the debug counters (static int volatile)
+    and the warn once flags (static bool first) are only used when
+    sending the document's data. */
+int checkHeadersInParallel(std::vector<MWAWInputStreamPtr> &inputs, std::vector<MWAWRSRCParserPtr> const &rsrcParsers,
+                           std::vector<MWAWHeader> &headers, bool strict, int numThreads)
+{
+  size_t numHeaders=headers.size();
+  if (inputs.size()!=numHeaders || rsrcParsers.size()!=numHeaders)
+    return -1;
+  std::atomic<size_t> nextId(0);
+  // the index of the first valid header found, the following headers do not need to be checked
+  std::atomic<size_t> firstValidId(numHeaders);
+  auto checkHeaders=[&]() {
+    while (true) {
+      size_t id=nextId++;
+      if (id>=numHeaders || id>firstValidId)
+        return;
+      if (!checkBasicMacHeader(inputs[id], rsrcParsers[id], headers[id], strict))
+        continue;
+      size_t actId=firstValidId;
+      while (id<actId && !firstValidId.compare_exchange_weak(actId, id)) {
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i=1; i<numHeaders && i<size_t(numThreads); ++i) {
+    try {
+      threads.push_back(std::thread(checkHeaders));
+    }
+    catch (std::system_error const &) {
+      MWAW_DEBUG_MSG(("MWAWDocumentInternal::checkHeadersInParallel: can not create a new thread\n"));
+      break;
+    }
+  }
+  checkHeaders();
+  for (auto &thread : threads)
+    thread.join();
+  return firstValidId<numHeaders ? int(firstValidId) : -1;
+}
+
 /** Wrapper to check a basic header of a mac file */
 bool checkBasicMacHeader(MWAWInputStreamPtr &input, MWAWRSRCParserPtr const &rsrcParser, MWAWHeader &header, bool strict)
 try
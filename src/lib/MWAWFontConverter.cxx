@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <cstring>
 #include <iostream>
 
 #include "libmwaw_internal.hxx"
@@ -45,34 +46,102 @@ namespace MWAWFontConverterInternal
 //! Internal and low level: tools to convert Macintosh characters
 namespace Data
 {
+//! Internal and low level: a flat table character -> unicode (0 if the character is not converted)
+typedef char32_t ConversionTable[256];
+
+//! Internal and low level: appends the UTF-8 encoding of a unicode character
+static void appendUTF8(char32_t unicode, std::string &utf8)
+{
+  if (unicode < 0x80)
+    utf8+=char(unicode);
+  else if (unicode < 0x800) {
+    utf8+=char(0xc0 | (unicode>>6));
+    utf8+=char(0x80 | (unicode&0x3f));
+  }
+  else if (unicode < 0x10000) {
+    utf8+=char(0xe0 | (unicode>>12));
+    utf8+=char(0x80 | ((unicode>>6)&0x3f));
+    utf8+=char(0x80 | (unicode&0x3f));
+  }
+  else {
+    utf8+=char(0xf0 | ((unicode>>18)&0x7));
+    utf8+=char(0x80 | ((unicode>>12)&0x3f));
+    utf8+=char(0x80 | ((unicode>>6)&0x3f));
+    utf8+=char(0x80 | (unicode&0x3f));
+  }
+}
+
 //! Internal and low level: a class to store a conversion map for character, ...
 struct ConversionData {
   //! constructor
-  explicit ConversionData(std::map<unsigned char, unsigned long> &map,
+  explicit ConversionData(ConversionTable const &table,
                           char const *odtName="", int delta=0)
     : m_encoding(MWAWFontConverter::E_DEFAULT)
-    , m_conversion(map)
+    , m_conversion(table)
     , m_name(odtName)
     , m_deltaSize(delta)
+    , m_utf8()
+    , m_asciiIsIdentity(false)
   {
   }
   //! constructor for different encoding
-  ConversionData(std::map<unsigned char, unsigned long> &map, MWAWFontConverter::Encoding encoding, char const *odtName="", int delta=0)
+  ConversionData(ConversionTable const &table, MWAWFontConverter::Encoding encoding, char const *odtName="", int delta=0)
     : m_encoding(encoding)
-    , m_conversion(map)
+    , m_conversion(table)
     , m_name(odtName)
     , m_deltaSize(delta)
+    , m_utf8()
+    , m_asciiIsIdentity(false)
   {
   }
+  /** initializes the UTF-8 table, must be called once the conversion table is filled
+
+      \note a character is converted as in MWAWListener::insertCharacter, ie. the control
+      characters are ignored and the characters without conversion are kept unchanged */
+  void initUTF8()
+  {
+    m_asciiIsIdentity=true;
+    for (int c=0; c<256; ++c) {
+      UTF8Char &utf8=m_utf8[c];
+      utf8.m_length=0;
+      char32_t unicode=m_conversion[c];
+      if (c>=0x20 && c<0x80 && unicode!=char32_t(c))
+        m_asciiIsIdentity=false;
+      if (c<0x20) continue;
+      if (!unicode) unicode=char32_t(c);
+      if (unicode==0xfffd) continue;
+      std::string str;
+      appendUTF8(unicode, str);
+      utf8.m_length=static_cast<unsigned char>(str.size());
+      std::memcpy(utf8.m_bytes, str.c_str(), str.size());
+    }
+  }
+  //! returns the unicode character or -1
+  int unicode(unsigned char c) const
+  {
+    char32_t res=m_conversion[c];
+    return res ? static_cast<int>(res) : -1;
+  }
 
   //! the character encoding
   MWAWFontConverter::Encoding m_encoding;
-  //! the conversion map character -> unicode
-  std::map<unsigned char, unsigned long> &m_conversion;
+  //! the conversion table character -> unicode
+  ConversionTable const &m_conversion;
   //! the odt font name (if empty used the name)
   std::string m_name;
   //! the size delta: odtSize = fSize + deltaSize
   int m_deltaSize;
+  //! a UTF-8 character
+  struct UTF8Char {
+    //! the number of bytes
+    unsigned char m_length;
+    //! the bytes
+    char m_bytes[4];
+  };
+  //! the conversion table character -> UTF-8
+  UTF8Char m_utf8[256];
+  //! a flag to know if the characters 0x20-0x7f are not modified
+  bool m_asciiIsIdentity;
 };
 
 // Courtesy of unicode.org: http://unicode.org/Public/MAPPINGS/VENDORS/APPLE/ROMAN.TXT
@@ -632,9 +701,28 @@ static int const s_windowsCP1258Unicode[] = {
   0xfd,0x1b0, 0xfe,0x20ab
 };
 
+/** Internal and low level: the conversion tables
+
+    \note these tables are never modified once created, so they are
+    created once and shared by all the converters, see get */
 class KnownConversion
 {
 public:
+  //! returns the conversion tables
+  static KnownConversion const &get()
+  {
+    static KnownConversion const conversion;
+    return conversion;
+  }
+  //! returns the conversion map which corresponds to a name (or to its family), or the default map
+  ConversionData const &getConversionMaps(std::string fName, std::map<std::string, std::string> const &familyMap) const;
+
+  //! return the default converter
+  ConversionData const &getDefault() const
+  {
+    return m_defaultConv;
+  }
+protected:
   //! constructor
   KnownConversion()
     : m_convertMap()
@@ -693,89 +781,73 @@ public:
   {
     initMaps();
   }
-  //! returns the conversion map which corresponds to a name, or the default map
-  Data::ConversionData const &getConversionMaps(std::string fName);
-
-  //! set a family correspondance
-  void setFamily(std::string const &fName, std::string const &family)
-  {
-    if (fName.length() && family.length())
-      m_familyMap[fName]=family;
-  }
-  //! return the default converter
-  ConversionData const &getDefault() const
-  {
-    return m_defaultConv;
-  }
-protected:
   //! Internal and Low level: initializes all the conversion maps
   void initMaps();
 
-  //! Internal and Low level: initializes a map with a vector of \a numElt elements (char, unicode)
-  static void initAMap(int const *arr, size_t numElt, std::map<unsigned char, unsigned long> &map)
+  //! Internal and Low level: initializes a table with a vector of \a numElt elements (char, unicode)
+  static void initAMap(int const *arr, size_t numElt, ConversionTable &table)
   {
     for (size_t i = 0; i < numElt; i++) {
       auto c = static_cast<unsigned char>(arr[2*i]);
-      auto unicode = static_cast<unsigned long>(arr[2*i+1]);
-      map[c] = unicode;
+      table[c] = static_cast<char32_t>(arr[2*i+1]);
     }
   }
 
   /** the conversiont map fName -> ConversionData */
   std::map<std::string, ConversionData const *> m_convertMap;
 
-  //! Internal and Low level: map font name -> family font name
+  //! Internal and Low level: the default map font name -> family font name
   std::map<std::string, std::string> m_familyMap;
 
-  //! Internal and Low level: map char -> unicode for roman font
-  std::map<unsigned char, unsigned long> m_romanMap;
-  //! Internal and Low level: map char -> unicode for central european font
-  std::map<unsigned char, unsigned long> m_centralEuroMap;
-  //! Internal and Low level: map char -> unicode for cyrillic font
-  std::map<unsigned char, unsigned long> m_cyrillicMap;
-  //! Internal and Low level: map char -> unicode for turkish font
-  std::map<unsigned char, unsigned long> m_turkishMap;
-
-  //! Internal and Low level: map char -> unicode for symbol font
-  std::map<unsigned char, unsigned long> m_symbolMap;
-  //! Internal and Low level: map char -> unicode for dingbats font
-  std::map<unsigned char, unsigned long> m_dingbatsMap;
-  //! Internal and Low level: map char -> unicode for cursive font
-  std::map<unsigned char, unsigned long> m_cursiveMap;
-  //! Internal and Low level: map char -> unicode for math font
-  std::map<unsigned char, unsigned long> m_mathMap;
-  //! Internal and Low level: map char -> unicode for monotypeSorts font
-  std::map<unsigned char, unsigned long> m_monotypeSortsMap;
-  //! Internal and Low level: map char -> unicode for scientific font
-  std::map<unsigned char, unsigned long> m_scientificMap;
-  //! Internal and Low level: map char -> unicode for wingdings font
-  std::map<unsigned char, unsigned long> m_wingdingsMap;
-  //! Internal and Low level: simplified map char -> unicode for SJIS font
-  std::map<unsigned char, unsigned long> m_SJISMap;
-  //! Internal and Low level: map char -> unicode for font 107
-  std::map<unsigned char, unsigned long> m_unknown107Map;
-  //! Internal and Low level: map char -> unicode for font 128
-  std::map<unsigned char, unsigned long> m_unknown128Map;
-  //! Internal and Low level: map char -> unicode for font 200
-  std::map<unsigned char, unsigned long> m_unknown200Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1250
-  std::map<unsigned char, unsigned long> m_windowsCP1250Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1251
-  std::map<unsigned char, unsigned long> m_windowsCP1251Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1252
-  std::map<unsigned char, unsigned long> m_windowsCP1252Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1253
-  std::map<unsigned char, unsigned long> m_windowsCP1253Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1254
-  std::map<unsigned char, unsigned long> m_windowsCP1254Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1255
-  std::map<unsigned char, unsigned long> m_windowsCP1255Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1256
-  std::map<unsigned char, unsigned long> m_windowsCP1256Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1257
-  std::map<unsigned char, unsigned long> m_windowsCP1257Map;
-  //! Internal and Low level: map char -> unicode for Windows CP1258
-  std::map<unsigned char, unsigned long> m_windowsCP1258Map;
+  //! Internal and Low level: table char -> unicode for roman font
+  ConversionTable m_romanMap;
+  //! Internal and Low level: table char -> unicode for central european font
+  ConversionTable m_centralEuroMap;
+  //! Internal and Low level: table char -> unicode for cyrillic font
+  ConversionTable m_cyrillicMap;
+  //! Internal and Low level: table char -> unicode for turkish font
+  ConversionTable m_turkishMap;
+
+  //! Internal and Low level: table char -> unicode for symbol font
+  ConversionTable m_symbolMap;
+  //! Internal and Low level: table char -> unicode for dingbats font
+  ConversionTable m_dingbatsMap;
+  //! Internal and Low level: table char -> unicode for cursive font
+  ConversionTable m_cursiveMap;
+  //! Internal and Low level: table char -> unicode for math font
+  ConversionTable m_mathMap;
+  //! Internal and Low level: table char -> unicode for monotypeSorts font
+  ConversionTable m_monotypeSortsMap;
+  //! Internal and Low level: table char -> unicode for scientific font
+  ConversionTable m_scientificMap;
+  //! Internal and Low level: table char -> unicode for wingdings font
+  ConversionTable m_wingdingsMap;
+  //! Internal and Low level: simplified table char -> unicode for SJIS font
+  ConversionTable m_SJISMap;
+  //! Internal and Low level: table char -> unicode for font 107
+  ConversionTable m_unknown107Map;
+  //! Internal and Low level: table char -> unicode for font 128
+  ConversionTable m_unknown128Map;
+  //! Internal and Low level: table char -> unicode for font 200
+  ConversionTable m_unknown200Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1250
+  ConversionTable m_windowsCP1250Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1251
+  ConversionTable m_windowsCP1251Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1252
+  ConversionTable m_windowsCP1252Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1253
+  ConversionTable m_windowsCP1253Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1254
+  ConversionTable m_windowsCP1254Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1255
+  ConversionTable m_windowsCP1255Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1256
+  ConversionTable m_windowsCP1256Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1257
+  ConversionTable m_windowsCP1257Map;
+  //! Internal and Low level: table char -> unicode for Windows CP1258
+  ConversionTable m_windowsCP1258Map;
 
   //! Internal and Low level: the default converter: roman
   ConversionData m_defaultConv;
@@ -840,17 +912,15 @@ void KnownConversion::initMaps()
   size_t numRoman = sizeof(s_romanUnicode)/(2*sizeof(int));
   for (size_t i = 0; i < numRoman; i++) {
     auto c = static_cast<unsigned char>(s_romanUnicode[2*i]);
-    auto unicode = static_cast<unsigned long>(s_romanUnicode[2*i+1]);
+    auto unicode = static_cast<char32_t>(s_romanUnicode[2*i+1]);
     m_romanMap[c] = m_turkishMap[c] = unicode;
     m_cursiveMap[c] = m_mathMap[c] = m_scientificMap[c] = unicode;
     m_unknown107Map[c] = m_unknown128Map[c] = m_unknown200Map[c] = unicode;
   }
-  for (unsigned long c=0x20; c<=0xff; ++c)
-    m_windowsCP1250Map[static_cast<unsigned char>(c)]=m_windowsCP1251Map[static_cast<unsigned char>(c)]=
-          m_windowsCP1252Map[static_cast<unsigned char>(c)]=m_windowsCP1253Map[static_cast<unsigned char>(c)]=
-                m_windowsCP1254Map[static_cast<unsigned char>(c)]=m_windowsCP1255Map[static_cast<unsigned char>(c)]=
-                      m_windowsCP1256Map[static_cast<unsigned char>(c)]=m_windowsCP1257Map[static_cast<unsigned char>(c)]=
-                            m_windowsCP1258Map[static_cast<unsigned char>(c)]=c;
+  for (char32_t c=0x20; c<=0xff; ++c)
+    m_windowsCP1250Map[c]=m_windowsCP1251Map[c]=m_windowsCP1252Map[c]=m_windowsCP1253Map[c]=
+                            m_windowsCP1254Map[c]=m_windowsCP1255Map[c]=m_windowsCP1256Map[c]=m_windowsCP1257Map[c]=
+                                  m_windowsCP1258Map[c]=c;
   initAMap(s_centralEuroUnicode, sizeof(s_centralEuroUnicode)/(2*sizeof(int)), m_centralEuroMap);
   initAMap(s_cyrillicUnicode, sizeof(s_cyrillicUnicode)/(2*sizeof(int)), m_cyrillicMap);
   initAMap(s_turkishUnicode, sizeof(s_turkishUnicode)/(2*sizeof(int)), m_turkishMap);
@@ -917,17 +987,34 @@ void KnownConversion::initMaps()
   m_familyMap["Hiragino Kakugo W8"]="Osaka";
   m_familyMap["Hiragino San GB W3"]="Osaka"; // checkme
   m_familyMap["Hiragino San GB W6"]="Osaka"; // checkme
+
+  for (auto *conv : {
+         &m_defaultConv, &m_centralEuroConv, &m_cyrillicConv, &m_turkishConv, &m_timeConv, &m_zapfChanceryConv,
+         &m_symbolConv, &m_dingbatsConv, &m_cursiveConv, &m_mathConv, &m_monotypeSortsConv, &m_scientificConv,
+         &m_wingdingsConv, &m_SJISConv, &m_unknown107Conv, &m_unknown128Conv, &m_unknown200Conv,
+         &m_windowsCP1250Conv, &m_windowsCP1251Conv, &m_windowsCP1252Conv, &m_windowsCP1253Conv, &m_windowsCP1254Conv,
+         &m_windowsCP1255Conv, &m_windowsCP1256Conv, &m_windowsCP1257Conv, &m_windowsCP1258Conv
+       })
+    conv->initUTF8();
 }
 
-ConversionData const &KnownConversion::getConversionMaps(std::string fName)
+ConversionData const &KnownConversion::getConversionMaps(std::string fName, std::map<std::string, std::string> const &familyMap) const
 {
   if (fName.empty()) return m_defaultConv;
   auto it= m_convertMap.find(fName);
   if (it != m_convertMap.end()) return *(it->second);
 
-  // look for a family map
-  auto famIt= m_familyMap.find(fName);
-  if (famIt == m_familyMap.end()) {
+  // look for a family map: first the user's correspondances, then the default ones
+  std::string const *family=nullptr;
+  auto famIt= familyMap.find(fName);
+  if (famIt != familyMap.end())
+    family=&famIt->second;
+  else {
+    famIt = m_familyMap.find(fName);
+    if (famIt != m_familyMap.end())
+      family=&famIt->second;
+  }
+  if (!family) {
     // checkme maybe ok for pre-OS7, ... but not for WorldScript
     size_t len=fName.length();
     if (len > 4 && fName.substr(len-4,4)==" CYR")
@@ -942,8 +1029,7 @@ ConversionData const &KnownConversion::getConversionMaps(std::string fName)
     }
     return m_defaultConv;
   }
-  fName = famIt->second;
-  it= m_convertMap.find(fName);
+  it= m_convertMap.find(*family);
   if (it != m_convertMap.end()) return *(it->second);
   return  m_defaultConv;
 }
@@ -955,13 +1041,39 @@ ConversionData const &KnownConversion::getConversionMaps(std::string fName)
 // Font convertor imlementation
 //
 //------------------------------------------------------------
+//! the default correspondances between the font ids and the font names, shared by all the converters
+struct FontNames {
+  //! returns the default correspondances
+  static FontNames const &get()
+  {
+    static FontNames const names;
+    return names;
+  }
+  //! map sysid -> font name
+  std::map<int, std::string> m_idNameMap;
+  //! map font name -> sysid
+  std::map<std::string, int> m_nameIdMap;
+protected:
+  //! constructor
+  FontNames()
+    : m_idNameMap()
+    , m_nameIdMap()
+  {
+    initMaps();
+  }
+  //! initializes the maps
+  void initMaps();
+};
+
 //! the default font converter
 class State
 {
 public:
   //! the constructor
   State()
-    : m_knownConversion()
+    : m_knownConversion(MWAWFontConverterInternal::Data::KnownConversion::get())
+    , m_familyMap()
+    , m_defaultNames(FontNames::get())
     , m_idNameMap()
     , m_nameIdMap()
     , m_nameIdCounter(0)
@@ -969,13 +1081,13 @@ public:
     , m_sjisConverter()
     , m_unicodeCache()
   {
-    initMaps();
   }
 
   /** returns an unused id */
   int getUnusedId()
   {
-    while (m_idNameMap.find(m_uniqueId)!=m_idNameMap.end())
+    while (m_idNameMap.find(m_uniqueId)!=m_idNameMap.end() ||
+           m_defaultNames.m_idNameMap.find(m_uniqueId)!=m_defaultNames.m_idNameMap.end())
       m_uniqueId++;
     return m_uniqueId;
   }
@@ -987,6 +1099,8 @@ public:
     if (name.empty()) return -1;
     auto it=m_nameIdMap.find(name);
     if (it != m_nameIdMap.end()) return it->second;
+    auto defIt=m_defaultNames.m_nameIdMap.find(name);
+    if (defIt != m_defaultNames.m_nameIdMap.end()) return defIt->second;
     int newId=getUnusedId();
     setCorrespondance(newId, name, family);
     return newId;
@@ -996,8 +1110,10 @@ public:
   std::string getName(int macId)
   {
     auto it=m_idNameMap.find(macId);
-    if (it==m_idNameMap.end()) return "";
-    return it->second;
+    if (it!=m_idNameMap.end()) return it->second;
+    auto defIt=m_defaultNames.m_idNameMap.find(macId);
+    if (defIt!=m_defaultNames.m_idNameMap.end()) return defIt->second;
+    return "";
   }
 
   /* converts a character in unicode
@@ -1010,6 +1126,8 @@ public:
   /** converts a character in unicode, if needed can read the next input caracter in str
       \return -1 if the character is not transformed */
   int unicode(int macId, unsigned char c, unsigned char const *(&str), int len);
+  //! converts a run of characters in UTF-8
+  void convert(int macId, uint8_t const *data, size_t len, std::string &utf8);
   /** final font name and a delta which can be used to change the size
   if no name is found, return "Times New Roman" */
   void getOdtInfo(int macId, std::string &nm, int &deltaSize);
@@ -1020,21 +1138,23 @@ public:
     m_idNameMap[macId] = name;
     m_nameIdMap[name] = macId;
     m_nameIdCounter++;
-    if (family.length())
-      m_knownConversion.setFamily(name,family);
+    if (name.length() && family.length())
+      m_familyMap[name]=family;
   }
 
 protected:
-  //! initializes the map
-  void initMaps();
   //! try to update the cache
   bool updateCache(int macId);
 
   //! the basic conversion map
-  MWAWFontConverterInternal::Data::KnownConversion m_knownConversion;
-  //! map sysid -> font name
+  MWAWFontConverterInternal::Data::KnownConversion const &m_knownConversion;
+  //! map font name -> family font name
+  std::map<std::string, std::string> m_familyMap;
+  //! the default correspondances sysid <-> font name
+  FontNames const &m_defaultNames;
+  //! map sysid -> font name (which completes the default map)
   std::map<int, std::string> m_idNameMap;
-  //! map font name -> sysid
+  //! map font name -> sysid (which completes the default map)
   std::map<std::string, int> m_nameIdMap;
 
   //!Internal: a counter modified when a new correspondance name<->id is found
@@ -1066,7 +1186,7 @@ protected:
 };
 
 // initializes the default conversion map
-void State::initMaps()
+void FontNames::initMaps()
 {
   // see http://developer.apple.com/documentation/mac/Text/Text-277.html
   // or Apple II Technical Notes #41 (  http://www.umich.edu/~archive/apple2/technotes/tn/iigs/TN.IIGS.041 )
@@ -1188,7 +1308,7 @@ bool State::updateCache(int macId)
   if (!m_unicodeCache.m_conv || m_unicodeCache.m_macId != macId ||  m_unicodeCache.m_nameIdCounter != m_nameIdCounter) {
     m_unicodeCache.m_macId = macId;
     m_unicodeCache.m_nameIdCounter = m_nameIdCounter;
-    m_unicodeCache.m_conv = &m_knownConversion.getConversionMaps(getName(macId));
+    m_unicodeCache.m_conv = &m_knownConversion.getConversionMaps(getName(macId), m_familyMap);
   }
   if (!m_unicodeCache.m_conv) {
     MWAW_DEBUG_MSG(("unicode Error: can not find a convertor\n"));
@@ -1202,9 +1322,7 @@ int State::unicode(int macId, unsigned char c)
 {
   if (!updateCache(macId))
     return -1;
-  auto it = m_unicodeCache.m_conv->m_conversion.find(c);
-  if (it == m_unicodeCache.m_conv->m_conversion.end()) return -1;
-  return static_cast<int>(it->second);
+  return m_unicodeCache.m_conv->unicode(c);
 }
 
 // returns an unicode caracter
@@ -1218,9 +1336,7 @@ int State::unicode(int macId, unsigned char c, MWAWInputStreamPtr &input)
     return m_sjisConverter->unicode(c,input);
   }
 
-  auto it = m_unicodeCache.m_conv->m_conversion.find(c);
-  if (it == m_unicodeCache.m_conv->m_conversion.end()) return -1;
-  return static_cast<int>(it->second);
+  return m_unicodeCache.m_conv->unicode(c);
 }
 
 int State::unicode(int macId, unsigned char c, unsigned char const *(&str), int len)
@@ -1233,15 +1349,70 @@ int State::unicode(int macId, unsigned char c, unsigned char const *(&str), int
     return m_sjisConverter->unicode(c,str,len);
   }
 
-  auto it = m_unicodeCache.m_conv->m_conversion.find(c);
-  if (it == m_unicodeCache.m_conv->m_conversion.end()) return -1;
-  return static_cast<int>(it->second);
+  return m_unicodeCache.m_conv->unicode(c);
+}
+
+//! returns true if the 8 characters are between 0x20 and 0x7f
+static bool isPrintableASCII(uint8_t const *data)
+{
+  uint64_t val;
+  std::memcpy(&val, data, 8);
+  // no byte >= 0x80 and, as no carry is possible, no byte+0x60 < 0x80
+  return (val & 0x8080808080808080ULL)==0 &&
+         ((val+0x6060606060606060ULL) & 0x8080808080808080ULL)==0x8080808080808080ULL;
+}
+
+void State::convert(int macId, uint8_t const *data, size_t len, std::string &utf8)
+{
+  if (!data || !len || !updateCache(macId))
+    return;
+  auto const &conv=*m_unicodeCache.m_conv;
+  utf8.reserve(utf8.size()+len);
+  if (conv.m_encoding==MWAWFontConverter::E_SJIS) {
+    if (!m_sjisConverter)
+      m_sjisConverter.reset(new MWAWFontSJISConverter);
+    std::u32string unicodes;
+    m_sjisConverter->decode(data, len, unicodes);
+    for (auto unicode : unicodes) {
+      if (unicode>=0x20 && unicode!=0xfffd)
+        MWAWFontConverterInternal::Data::appendUTF8(unicode, utf8);
+    }
+    return;
+  }
+  // the non ASCII characters are stored in a small buffer to avoid appending them one by one
+  char buffer[256];
+  size_t bufferLen=0;
+  size_t i=0;
+  while (i<len) {
+    if (conv.m_asciiIsIdentity) {
+      size_t j=i;
+      while (j+8<=len && isPrintableASCII(data+j))
+        j+=8;
+      while (j<len && data[j]>=0x20 && data[j]<0x80)
+        ++j;
+      if (j>i) {
+        utf8.append(buffer, bufferLen);
+        bufferLen=0;
+        utf8.append(reinterpret_cast<char const *>(data+i), j-i);
+        i=j;
+        continue;
+      }
+    }
+    if (bufferLen+4>sizeof(buffer)) {
+      utf8.append(buffer, bufferLen);
+      bufferLen=0;
+    }
+    auto const &ch=conv.m_utf8[data[i++]];
+    std::memcpy(buffer+bufferLen, ch.m_bytes, 4);
+    bufferLen+=ch.m_length;
+  }
+  utf8.append(buffer, bufferLen);
 }
 
 void State::getOdtInfo(int macId, std::string &nm, int &deltaSize)
 {
   std::string nam = getName(macId);
-  auto const *conv = &m_knownConversion.getConversionMaps(nam);
+  auto const *conv = &m_knownConversion.getConversionMaps(nam, m_familyMap);
 
   nm = conv->m_name;
   deltaSize = conv->m_deltaSize;
@@ -1330,4 +1501,9 @@ int MWAWFontConverter::unicode(int macId, unsigned char c, unsigned char const *
   if (c < 0x20) return -1;
   return m_manager->unicode(macId,c,str,len);
 }
+
+void MWAWFontConverter::convert(int macId, uint8_t const *data, size_t len, std::string &utf8) const
+{
+  m_manager->convert(macId, data, len, utf8);
+}
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
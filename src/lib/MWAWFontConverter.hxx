@@ -96,6 +96,13 @@ public:
   /** converts a character in unicode, if needed can read the next input caracter in str
      \return -1 if the character is not transformed */
   int unicode(int macId, unsigned char c, unsigned char const *(&str), int len) const;
+  /** converts a run of characters in UTF-8 and appends the result to utf8.
+
+     The characters are converted as by MWAWListener::insertCharacter(c, input, endPos),
+     ie. the control characters are ignored, the characters which can not be
+     converted are kept unchanged and the two bytes characters of a SJIS font are decoded.
+   */
+  void convert(int macId, uint8_t const *data, size_t len, std::string &utf8) const;
 protected:
   /** check if a string is valid, if not, convert it to a valid string */
   static std::string getValidName(std::string const &name);
@@ -1496,56 +1496,133 @@ static uint32_t const s_SJIS_encoding2[]= {
 * instead of those above.
 */
 
+//! Internal: namespace used to define the SJIS conversion tables
+namespace MWAWFontSJISConverterInternal
+{
+//! the number of lead bytes: 0x81-0x9F and 0xE0-0xFC
+static int const s_numLeadBytes=0x1F+0x1D;
+
+//! returns the row corresponding to a lead byte
+static int getRow(unsigned char c)
+{
+  return c <= 0x9F ? int(c)-0x81 : int(c)-0xE0+0x1F;
+}
+
+/** the direct-indexed conversion tables: a table for the one byte
+    characters and a table for each lead byte, 0 meaning that the
+    character can not be converted
+
+    \note the tables are never modified once created, so they are
+    created at the first use and shared by all the converters */
+struct Tables {
+  //! returns the tables
+  static Tables const &get()
+  {
+    static Tables const tables;
+    return tables;
+  }
+  //! the one byte characters table
+  char32_t m_single[256];
+  //! the two bytes characters tables: lead byte's row x trail byte
+  char32_t m_double[s_numLeadBytes][256];
+protected:
+  //! constructor: fills the tables
+  Tables()
+    : m_single()
+    , m_double()
+  {
+    size_t numData=MWAW_N_ELEMENTS(libmwaw::s_SJIS_encoding);
+    for (size_t i = 0; i+1 < numData; i+=2)
+      set(libmwaw::s_SJIS_encoding[i], libmwaw::s_SJIS_encoding[i+1]);
+    // fixme do differently
+    numData=MWAW_N_ELEMENTS(libmwaw::s_SJIS_encoding2);
+    for (size_t i = 0; i+2 < numData; i+=3)
+      set(libmwaw::s_SJIS_encoding2[i], libmwaw::s_SJIS_encoding2[i+1]);
+  }
+  //! sets a correspondance
+  void set(uint32_t sjisChar, uint32_t unicode)
+  {
+    if (sjisChar < 0x100)
+      m_single[sjisChar]=char32_t(unicode);
+    else if (sjisChar < 0x10000 && (((sjisChar>>8) >= 0x81 && (sjisChar>>8) <= 0x9F) || ((sjisChar>>8) >= 0xE0 && (sjisChar>>8) <= 0xFC)))
+      m_double[getRow(static_cast<unsigned char>(sjisChar>>8))][sjisChar&0xFF]=char32_t(unicode);
+    else {
+      MWAW_DEBUG_MSG(("MWAWFontSJISConverterInternal::Tables::set: unexpected character %x\n", unsigned(sjisChar)));
+    }
+  }
+};
+}
+
 ////////////////////////////////////////////////////////////
 // MWAWFontSJISConverter code
 ////////////////////////////////////////////////////////////
 MWAWFontSJISConverter::MWAWFontSJISConverter()
-  : m_sjisUnicodeMap()
 {
-  initMap();
 }
 
 MWAWFontSJISConverter::~MWAWFontSJISConverter()
 {
 }
 
-void MWAWFontSJISConverter::initMap()
+char32_t MWAWFontSJISConverter::getUnicode(unsigned char c)
+{
+  return MWAWFontSJISConverterInternal::Tables::get().m_single[c];
+}
+
+char32_t MWAWFontSJISConverter::getUnicode(unsigned char c, unsigned char c2)
 {
-  size_t numData=MWAW_N_ELEMENTS(libmwaw::s_SJIS_encoding);
-  for (size_t i = 0; i+1 < numData; i+=2)
-    m_sjisUnicodeMap[int(libmwaw::s_SJIS_encoding[i])]=int(libmwaw::s_SJIS_encoding[i+1]);
-  // fixme do differently
-  numData=MWAW_N_ELEMENTS(libmwaw::s_SJIS_encoding2);
-  for (size_t i = 0; i+2 < numData; i+=3)
-    m_sjisUnicodeMap[int(libmwaw::s_SJIS_encoding2[i])]=int(libmwaw::s_SJIS_encoding2[i+1]);
+  return MWAWFontSJISConverterInternal::Tables::get().m_double[MWAWFontSJISConverterInternal::getRow(c)][c2];
 }
 
 int MWAWFontSJISConverter::unicode(unsigned char c, MWAWInputStreamPtr &input)
 {
-  auto sjisChar = uint32_t(c);
-  long pos = input->tell();
-  if ((c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC)) {
-    if (input->isEnd()) return -1;
-    sjisChar = (sjisChar<<8)+uint32_t(input->readULong(1));
+  if (!isLeadByte(c)) {
+    char32_t res=getUnicode(c);
+    return res ? int(res) : -1;
   }
-  if (m_sjisUnicodeMap.find(int(sjisChar))!=m_sjisUnicodeMap.end())
-    return m_sjisUnicodeMap.find(int(sjisChar))->second;
+  if (input->isEnd()) return -1;
+  long pos = input->tell();
+  char32_t res=getUnicode(c, static_cast<unsigned char>(input->readULong(1)));
+  if (res) return int(res);
   input->seek(pos, librevenge::RVNG_SEEK_SET);
   return -1;
 }
 
 int  MWAWFontSJISConverter::unicode(unsigned char c, unsigned char const *(&str), int len)
 {
-  auto sjisChar = uint32_t(c);
-  unsigned char const *pos=str;
-  if ((c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC)) {
-    if (len <= 0) return -1;
-    sjisChar = (sjisChar<<8)+uint32_t(*(str++));
+  if (!isLeadByte(c)) {
+    char32_t res=getUnicode(c);
+    return res ? int(res) : -1;
   }
-  if (m_sjisUnicodeMap.find(int(sjisChar))!=m_sjisUnicodeMap.end())
-    return m_sjisUnicodeMap.find(int(sjisChar))->second;
-  str=pos;
-  return -1;
+  if (len <= 0) return -1;
+  char32_t res=getUnicode(c, *str);
+  if (!res) return -1;
+  ++str;
+  return int(res);
+}
+
+size_t MWAWFontSJISConverter::decode(uint8_t const *data, size_t len, std::u32string &res) const
+{
+  if (!data) return 0;
+  auto const &tables=MWAWFontSJISConverterInternal::Tables::get();
+  size_t numBad=0;
+  res.reserve(res.size()+len);
+  for (size_t i=0; i<len; ++i) {
+    unsigned char c=data[i];
+    char32_t unicode=0;
+    if (!isLeadByte(c))
+      unicode=tables.m_single[c];
+    else if (i+1<len) {
+      unicode=tables.m_double[MWAWFontSJISConverterInternal::getRow(c)][data[i+1]];
+      if (unicode) ++i;
+    }
+    if (!unicode) {
+      ++numBad;
+      unicode=char32_t(c);
+    }
+    res.push_back(unicode);
+  }
+  return numBad;
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
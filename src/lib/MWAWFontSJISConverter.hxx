@@ -38,11 +38,13 @@
 #ifndef MWAW_FONT_SJIS_CONVERTER
 #  define MWAW_FONT_SJIS_CONVERTER
 
-#include <map>
+#include <string>
 
 #include "libmwaw_internal.hxx"
 
 /*! \brief a namespace used to convert Mac SJIS font characters in unicode
+
+  \note the conversion tables are created once and shared by all the converters
  */
 class MWAWFontSJISConverter
 {
@@ -56,11 +58,21 @@ public:
   int unicode(unsigned char c, MWAWInputStreamPtr &input);
   //! try to return a unicode for a shift jis character ( returns -1 if the character can not be converted )
   int unicode(unsigned char c, unsigned char const *(&str), int len);
-  //!init the mapping
-  void initMap();
+  /** converts a shift jis string in unicode and appends the result to \a res.
+
+      \note the characters which can not be converted are appended unchanged
+      \return the number of characters which can not be converted */
+  size_t decode(uint8_t const *data, size_t len, std::u32string &res) const;
 protected:
-  //! a map sjis->unicode
-  std::map<int,int> m_sjisUnicodeMap;
+  //! returns true if c is the first byte of a two bytes character
+  static bool isLeadByte(unsigned char c)
+  {
+    return (c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC);
+  }
+  //! returns the unicode corresponding to a one byte character or 0
+  static char32_t getUnicode(unsigned char c);
+  //! returns the unicode corresponding to a two bytes character or 0
+  static char32_t getUnicode(unsigned char c, unsigned char c2);
 };
 
 #endif
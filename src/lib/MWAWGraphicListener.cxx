@@ -51,10 +51,12 @@
 #include "MWAWList.hxx"
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
+#include "MWAWPictBitmap.hxx"
 #include "MWAWPosition.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
+#include "MWAWTextBuffer.hxx"
 
 #include "MWAWGraphicListener.hxx"
 
@@ -68,6 +70,7 @@ struct GraphicState {
     : m_pageList(pageList)
     , m_metaData()
     , m_isDocumentStarted(false)
+    , m_isEmbedded(false)
     , m_isPageSpanOpened(false)
     , m_isMasterPageSpanOpened(false)
     , m_isAtLeastOnePageOpened(false)
@@ -90,6 +93,8 @@ struct GraphicState {
   librevenge::RVNGPropertyList m_metaData;
   /** a flag to know if the document is open */
   bool m_isDocumentStarted;
+  /** a flag to know if the listener creates an embedded graphic, ie. sends its data to an encoder */
+  bool m_isEmbedded;
   //! true if a page is open
   bool m_isPageSpanOpened;
   //! true if a masterpage is open
@@ -124,8 +129,8 @@ struct State {
   }
   //! the origin position
   MWAWVec2f m_origin;
-  //! a buffer to stored the text
-  librevenge::RVNGString m_textBuffer;
+  //! the text buffer
+  MWAWTextBuffer m_textBuffer;
 
   //! the font
   MWAWFont m_font;
@@ -176,7 +181,7 @@ private:
 
 State::State()
   : m_origin(0,0)
-  , m_textBuffer("")
+  , m_textBuffer()
   , m_font(20,12)/* default time 12 */
   , m_paragraph()
   , m_list()
@@ -230,6 +235,7 @@ MWAWGraphicListener::MWAWGraphicListener(MWAWParserState &parserState, MWAWBox2f
   pageSpan.setFormWidth(double(box.size().x())/72.);
   pageSpan.setFormLength(double(box.size().y())/72.);
   m_ds.reset(new MWAWGraphicListenerInternal::GraphicState(std::vector<MWAWPageSpan>(1, pageSpan)));
+  m_ds->m_isEmbedded=true;
   m_ps->m_origin=box[0];
 }
 
@@ -260,16 +266,9 @@ void MWAWGraphicListener::insertCharacter(unsigned char c)
     MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacter: called outside a text zone\n"));
     return;
   }
-  int unicode = m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), c);
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWGraphicListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWGraphicListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, unicode))
+    MWAWGraphicListener::insertUnicode(unicode);
 }
 
 int MWAWGraphicListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos)
@@ -282,30 +281,29 @@ int MWAWGraphicListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &in
     MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacter: input or font converter does not exist!!!!\n"));
     return 0;
   }
-  long debPos=input->tell();
-  int fId = m_ps->m_font.id();
-  int unicode = endPos==debPos ?
-                m_parserState.m_fontConverter->unicode(fId, c) :
-                m_parserState.m_fontConverter->unicode(fId, c, input);
-
-  long pos=input->tell();
-  if (endPos > 0 && pos > endPos) {
-    MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacter: problem reading a character\n"));
-    pos = debPos;
-    input->seek(pos, librevenge::RVNG_SEEK_SET);
-    unicode = m_parserState.m_fontConverter->unicode(fId, c);
-  }
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWGraphicListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWGraphicListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  int numRead;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, input, endPos, unicode, numRead))
+    MWAWGraphicListener::insertUnicode(unicode);
+  return numRead;
+}
 
-  return int(pos-debPos);
+void MWAWGraphicListener::insertCharacters(uint8_t const *data, size_t len)
+{
+  if (!m_ps->isInTextZone()) {
+    MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacters: called outside a text zone\n"));
+    return;
+  }
+  if (!data || !len) return;
+  if (!m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWGraphicListener::insertCharacters: the font converter does not exist!!!!\n"));
+    return;
+  }
+  std::string utf8;
+  m_parserState.m_fontConverter->convert(m_ps->m_font.id(), data, len, utf8);
+  if (utf8.empty()) return;
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(utf8);
 }
 
 void MWAWGraphicListener::insertUnicode(uint32_t val)
@@ -318,7 +316,7 @@ void MWAWGraphicListener::insertUnicode(uint32_t val)
   if (val == 0xfffd) return;
 
   if (!m_ps->m_isSpanOpened) _openSpan();
-  libmwaw::appendUnicode(val, m_ps->m_textBuffer);
+  m_ps->m_textBuffer.appendUnicode(val);
 }
 
 void MWAWGraphicListener::insertUnicodeString(librevenge::RVNGString const &str)
@@ -572,6 +570,11 @@ void MWAWGraphicListener::_openPageSpan(bool sendHeaderFooters)
     MWAW_DEBUG_MSG(("MWAWGraphicListener::_openPageSpan: can not find any page\n"));
     throw libmwaw::ParseException();
   }
+  if (!m_parserState.isPageSent(int(m_ps->m_currentPage))) {
+    // the last requested page is sent, stop the parsing
+    m_parserState.m_maxPagesReached=true;
+    throw libmwaw::ParseException();
+  }
   m_ds->m_isAtLeastOnePageOpened=true;
   unsigned actPage = 0;
   auto it = m_ds->m_pageList.begin();
@@ -743,18 +746,7 @@ void MWAWGraphicListener::_closeListElement()
 
 int MWAWGraphicListener::_getListId() const
 {
-  auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
-  if (newLevel == 0) return -1;
-  int newListId = m_ps->m_paragraph.m_listId.get();
-  if (newListId > 0) return newListId;
-  static bool first = true;
-  if (first) {
-    MWAW_DEBUG_MSG(("MWAWGraphicListener::_getListId: the list id is not set, try to find a new one\n"));
-    first = false;
-  }
-  auto list=m_parserState.m_listManager->getNewList(m_ps->m_list, int(newLevel), *m_ps->m_paragraph.m_listLevel);
-  if (!list) return -1;
-  return list->getId();
+  return m_parserState.m_listManager->getListId(m_ps->m_paragraph, m_ps->m_list);
 }
 
 void MWAWGraphicListener::_changeList()
@@ -766,52 +758,15 @@ void MWAWGraphicListener::_changeList()
   if (m_ps->m_isParagraphOpened)
     _closeParagraph();
 
-  size_t actualLevel = m_ps->m_listOrderedLevels.size();
   auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
   if (newLevel>100) {
     MWAW_DEBUG_MSG(("MWAWGraphicListener::_changeList: find level=%d, set it to 100\n", static_cast<int>(newLevel)));
     newLevel=100;
   }
   int newListId = newLevel>0 ? _getListId() : -1;
-  bool changeList = newLevel &&
-                    (m_ps->m_list && m_ps->m_list->getId()!=newListId);
-  size_t minLevel = changeList ? 0 : newLevel;
-  while (actualLevel > minLevel) {
-    if (m_ps->m_listOrderedLevels[--actualLevel])
-      m_documentInterface->closeOrderedListLevel();
-    else
-      m_documentInterface->closeUnorderedListLevel();
-  }
-
-  if (newLevel) {
-    std::shared_ptr<MWAWList> theList;
-
-    theList=m_parserState.m_listManager->getList(newListId);
-    if (!theList) {
-      MWAW_DEBUG_MSG(("MWAWGraphicListener::_changeList: can not find any list\n"));
-      m_ps->m_listOrderedLevels.resize(actualLevel);
-      return;
-    }
-    m_parserState.m_listManager->needToSend(newListId, m_ds->m_sentListMarkers);
-    m_ps->m_list = theList;
-    m_ps->m_list->setLevel(static_cast<int>(newLevel));
-  }
-
-  m_ps->m_listOrderedLevels.resize(newLevel, false);
-  if (actualLevel == newLevel) return;
-
-  librevenge::RVNGPropertyList propList;
-  propList.insert("librevenge:list-id", m_ps->m_list->getId());
-  for (size_t i=actualLevel+1; i<= newLevel; i++) {
-    bool ordered = m_ps->m_list->isNumeric(int(i));
-    m_ps->m_listOrderedLevels[i-1] = ordered;
-
-    librevenge::RVNGPropertyList level;
-    m_ps->m_list->addTo(int(i), level, m_parserState.m_fontManager);
-    if (ordered)
-      m_documentInterface->openOrderedListLevel(level);
-    else
-      m_documentInterface->openUnorderedListLevel(level);
+  if (!m_parserState.m_listManager->changeLevels(*m_documentInterface, newListId, newLevel, m_ps->m_listOrderedLevels,
+      m_ps->m_list, m_ds->m_sentListMarkers)) {
+    MWAW_DEBUG_MSG(("MWAWGraphicListener::_changeList: can not find any list\n"));
   }
 }
 
@@ -868,30 +823,9 @@ void MWAWGraphicListener::_closeSpan()
 ///////////////////
 void MWAWGraphicListener::_flushText()
 {
-  if (m_ps->m_textBuffer.len() == 0) return;
-
-  // when some many ' ' follows each other, call insertSpace
-  librevenge::RVNGString tmpText("");
-  int numConsecutiveSpaces = 0;
-  librevenge::RVNGString::Iter i(m_ps->m_textBuffer);
-  for (i.rewind(); i.next();) {
-    if (*(i()) == 0x20) // this test is compatible with unicode format
-      numConsecutiveSpaces++;
-    else
-      numConsecutiveSpaces = 0;
+  if (m_ps->m_textBuffer.empty()) return;
 
-    if (numConsecutiveSpaces > 1) {
-      if (tmpText.len() > 0) {
-        m_documentInterface->insertText(tmpText);
-        tmpText.clear();
-      }
-      m_documentInterface->insertSpace();
-    }
-    else
-      tmpText.append(i());
-  }
-  m_documentInterface->insertText(tmpText);
-  m_ps->m_textBuffer.clear();
+  m_ps->m_textBuffer.flush(*m_documentInterface);
 }
 
 ///////////////////
@@ -1106,7 +1040,11 @@ void MWAWGraphicListener::insertPicture(MWAWPosition const &pos, MWAWEmbeddedObj
     list.insert("librevenge:rotate-cx",double(center[0]), librevenge::RVNG_POINT);
     list.insert("librevenge:rotate-cy",double(center[1]), librevenge::RVNG_POINT);
   }
-  if (picture.addTo(list))
+  MWAWEmbeddedObject object(picture);
+  // the bitmaps of an embedded graphic are always encoded
+  if (!m_parserState.m_rawBitmaps || m_ds->m_isEmbedded)
+    MWAWPictBitmap::encodeRawData(object, m_parserState.m_parseOptions);
+  if (object.addTo(list))
     m_documentInterface->drawGraphicObject(list);
 }
 
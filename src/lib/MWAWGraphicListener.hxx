@@ -146,6 +146,9 @@ public:
       \return the number of extra character read
    */
   int insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos=-1) final;
+  /** insert a run of characters using the font converter to find the utf8
+      characters (the SJIS characters are decoded as in insertCharacter(c, input, endPos)) */
+  void insertCharacters(uint8_t const *data, size_t len) final;
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   void insertUnicode(uint32_t character) final;
@@ -423,7 +423,10 @@ void MWAWGraphicStyle::addTo(librevenge::RVNGPropertyList &list, bool only1D) co
       }
       else {
         MWAWEmbeddedObject picture;
-        if (m_pattern.getBinary(picture) && !picture.m_dataList.empty() && !picture.m_dataList[0].empty()) {
+        bool ok=m_pattern.getBinary(picture);
+        // the fill images are small and always encoded
+        if (ok) MWAWPictBitmap::encodeRawData(picture, MWAWDocument::ParseOptions());
+        if (ok && !picture.m_dataList.empty() && !picture.m_dataList[0].empty()) {
           list.insert("draw:fill", "bitmap");
           list.insert("draw:fill-image", picture.m_dataList[0].getBase64Data());
           list.insert("draw:fill-image-width", m_pattern.m_dim[0], librevenge::RVNG_POINT);
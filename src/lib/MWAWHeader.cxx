@@ -36,7 +36,11 @@
  */
 
 #include <string.h>
+
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <unordered_map>
 
 #include "libmwaw_internal.hxx"
 
@@ -46,6 +50,295 @@
 
 #include "MWAWHeader.hxx"
 
+namespace MWAWHeaderInternal
+{
+//! a finder info signature: a creator, a type and the corresponding document
+struct FinderSignature {
+  //! the creator
+  char const *m_creator;
+  //! the type
+  char const *m_type;
+  //! the document type
+  MWAWDocument::Type m_docType;
+  //! the document version
+  int m_version;
+  //! the document kind
+  MWAWDocument::Kind m_docKind;
+};
+
+//! the list of known finder info signatures
+static FinderSignature const s_finderSignatures[]= {
+  {"ACTA", "OTLN", MWAWDocument::MWAW_T_ACTA, 1, MWAWDocument::MWAW_K_TEXT},
+  {"ACTA", "otln", MWAWDocument::MWAW_T_ACTA, 2, MWAWDocument::MWAW_K_TEXT},
+  {"AISW", "SWDC", MWAWDocument::MWAW_T_SCRIPTWRITER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"AISW", "SWSP", MWAWDocument::MWAW_T_SCRIPTWRITER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"AISW", "SWWP", MWAWDocument::MWAW_T_SCRIPTWRITER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"APBP", "APBL", MWAWDocument::MWAW_T_DRAWINGTABLE, 1, MWAWDocument::MWAW_K_DRAW},
+  {"ARTX", "RIFF", MWAWDocument::MWAW_T_CORELPAINTER, 10, MWAWDocument::MWAW_K_PAINT},
+  {"BOBO", "CWDB", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DATABASE},
+  {"BOBO", "CWD2", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DATABASE},
+  {"BOBO", "sWDB", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DATABASE},
+  {"BOBO", "CWGR", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DRAW},
+  {"BOBO", "sWGR", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DRAW},
+  {"BOBO", "CWSS", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"BOBO", "CWS2", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"BOBO", "sWSS", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"BOBO", "CWPR", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_PRESENTATION},
+  {"BOBO", "CWPT", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_PAINT},
+  {"BOBO", "CWWP", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"BOBO", "CWW2", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"BOBO", "sWPP", MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"BWks", "BWwp", MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"BWks", "BWdb", MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DATABASE},
+  {"BWks", "BWdr", MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DRAW},
+  {"BWks", "BWpt", MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_PAINT},
+  {"BWks", "BWss", MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"CDrw", "dDrw", MWAWDocument::MWAW_T_CLARISDRAW, 1, MWAWDocument::MWAW_K_DRAW},
+  {"CDrw", "dDst", MWAWDocument::MWAW_T_CLARISDRAW, 1, MWAWDocument::MWAW_K_DRAW},
+  {"CDrw", "iLib", MWAWDocument::MWAW_T_CLARISDRAW, 1, MWAWDocument::MWAW_K_DRAW},
+  {"CRDW", "CKDT", MWAWDocument::MWAW_T_CRICKETDRAW, 1, MWAWDocument::MWAW_K_DRAW},
+  {"C#+A", "C#+D", MWAWDocument::MWAW_T_RAGTIME, 5, MWAWDocument::MWAW_K_TEXT},
+  {"C#+A", "C#+F", MWAWDocument::MWAW_T_RAGTIME, 5, MWAWDocument::MWAW_K_TEXT},
+  {"DAD2", "drw2", MWAWDocument::MWAW_T_CANVAS, 2, MWAWDocument::MWAW_K_DRAW},
+  {"DAD5", "drw2", MWAWDocument::MWAW_T_CANVAS, 2, MWAWDocument::MWAW_K_DRAW},
+  {"DAD5", "drw5", MWAWDocument::MWAW_T_CANVAS, 5, MWAWDocument::MWAW_K_DRAW},
+  {"DAD5", "drwt", MWAWDocument::MWAW_T_CANVAS, 5, MWAWDocument::MWAW_K_DRAW},
+  {"DAD5", "VINF", MWAWDocument::MWAW_T_CANVAS, 5, MWAWDocument::MWAW_K_PAINT},
+  {"DAD6", "drw6", MWAWDocument::MWAW_T_CANVAS, 6, MWAWDocument::MWAW_K_DRAW},
+  {"DAD6", "drwt", MWAWDocument::MWAW_T_CANVAS, 6, MWAWDocument::MWAW_K_DRAW},
+  {"DAD6", "VINF", MWAWDocument::MWAW_T_CANVAS, 6, MWAWDocument::MWAW_K_PAINT},
+  {"DAD7", "drw7", MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_DRAW},
+  {"DAD7", "drwt", MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_DRAW},
+  {"DAD7", "VINF", MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_PAINT},
+  {"DAD8", "drw8", MWAWDocument::MWAW_T_CANVAS, 8, MWAWDocument::MWAW_K_DRAW},
+  {"DAD8", "drwt", MWAWDocument::MWAW_T_CANVAS, 8, MWAWDocument::MWAW_K_DRAW},
+  {"DAD8", "VINF", MWAWDocument::MWAW_T_CANVAS, 8, MWAWDocument::MWAW_K_PAINT},
+  {"DAD9", "drwX", MWAWDocument::MWAW_T_CANVAS, 9, MWAWDocument::MWAW_K_DRAW},
+  {"DAD9", "drwt", MWAWDocument::MWAW_T_CANVAS, 9, MWAWDocument::MWAW_K_DRAW},
+  {"DADX", "drwX", MWAWDocument::MWAW_T_CANVAS, 9, MWAWDocument::MWAW_K_DRAW},
+  {"DADX", "drwt", MWAWDocument::MWAW_T_CANVAS, 9, MWAWDocument::MWAW_K_DRAW},
+  {"Dc@P", "APPL", MWAWDocument::MWAW_T_DOCMAKER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"Dk@P", "APPL", MWAWDocument::MWAW_T_DOCMAKER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"FHA2", "FHD2", MWAWDocument::MWAW_T_FREEHAND, 2, MWAWDocument::MWAW_K_DRAW},
+  {"FHA2", "FHT2", MWAWDocument::MWAW_T_FREEHAND, 2, MWAWDocument::MWAW_K_DRAW},
+  {"FS03", "WRT+", MWAWDocument::MWAW_T_WRITERPLUS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"FSPS", "RIFF", MWAWDocument::MWAW_T_CORELPAINTER, 1, MWAWDocument::MWAW_K_PAINT},
+  {"FSDA", "RIFF", MWAWDocument::MWAW_T_CORELPAINTER, 1, MWAWDocument::MWAW_K_PAINT},
+  {"FSX3", "RIFF", MWAWDocument::MWAW_T_CORELPAINTER, 3, MWAWDocument::MWAW_K_PAINT},
+  {"FWRT", "FWRM", MWAWDocument::MWAW_T_FULLWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"FWRT", "FWRT", MWAWDocument::MWAW_T_FULLWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"FWRT", "FWRI", MWAWDocument::MWAW_T_FULLWRITE, 2, MWAWDocument::MWAW_K_TEXT},
+  {"F#+A", "F#+D", MWAWDocument::MWAW_T_RAGTIME, 3, MWAWDocument::MWAW_K_TEXT},
+  {"F#+A", "F#+F", MWAWDocument::MWAW_T_RAGTIME, 3, MWAWDocument::MWAW_K_TEXT},
+  {"GM01", "GfMt", MWAWDocument::MWAW_T_MOUSEWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"HMiw", "IWDC", MWAWDocument::MWAW_T_HANMACWORDJ, 1, MWAWDocument::MWAW_K_TEXT},
+  {"HMdr", "DRD2", MWAWDocument::MWAW_T_HANMACWORDK, 1, MWAWDocument::MWAW_K_TEXT},
+  {"JAZZ", "JWPD", MWAWDocument::MWAW_T_JAZZLOTUS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"JAZZ", "JWKS", MWAWDocument::MWAW_T_JAZZLOTUS, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"JAZZ", "JDBS", MWAWDocument::MWAW_T_JAZZLOTUS, 1, MWAWDocument::MWAW_K_DATABASE},
+  {"LMAN", "TEXT", MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_DRAW},
+  {"LWTE", "TEXT", MWAWDocument::MWAW_T_LIGHTWAYTEXT, 1, MWAWDocument::MWAW_K_TEXT},
+  {"LWTE", "ttro", MWAWDocument::MWAW_T_LIGHTWAYTEXT, 1, MWAWDocument::MWAW_K_TEXT},
+  {"LWTR", "APPL", MWAWDocument::MWAW_T_LIGHTWAYTEXT, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MACA", "WORD", MWAWDocument::MWAW_T_MACWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MACD", "DRWG", MWAWDocument::MWAW_T_MACDRAFT, 1, MWAWDocument::MWAW_K_DRAW},
+  {"MART", "RSGF", MWAWDocument::MWAW_T_READYSETGO, 1, MWAWDocument::MWAW_K_DRAW},
+  {"MART", "RSGI", MWAWDocument::MWAW_T_READYSETGO, 2, MWAWDocument::MWAW_K_DRAW},
+  {"MAXW", "MWCT", MWAWDocument::MWAW_T_MAXWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MD40", "MDDC", MWAWDocument::MWAW_T_MACDRAFT, 4, MWAWDocument::MWAW_K_DRAW},
+  {"MD40", "MSYM", MWAWDocument::MWAW_T_MACDRAFT, 4, MWAWDocument::MWAW_K_DRAW},
+  {"MDFT", "DRWG", MWAWDocument::MWAW_T_MACDRAFT, 1, MWAWDocument::MWAW_K_DRAW},
+  {"MDPL", "DRWG", MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW},
+  {"MDPL", "STAT", MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW},
+  {"MDRW", "DRWG", MWAWDocument::MWAW_T_MACDRAW, 1, MWAWDocument::MWAW_K_DRAW},
+  {"MDsr", "APPL", MWAWDocument::MWAW_T_MACDOC, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MDvr", "MDdc", MWAWDocument::MWAW_T_MACDOC, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MEMR", "RSGR", MWAWDocument::MWAW_T_READYSETGO, 5, MWAWDocument::MWAW_K_DRAW},
+  {"MMBB", "MBBT", MWAWDocument::MWAW_T_MARINERWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MORE", "MORE", MWAWDocument::MWAW_T_MORE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"MOR2", "MOR2", MWAWDocument::MWAW_T_MORE, 2, MWAWDocument::MWAW_K_TEXT},
+  {"MOR2", "MOR3", MWAWDocument::MWAW_T_MORE, 3, MWAWDocument::MWAW_K_TEXT},
+  {"MPNT", "PNTG", MWAWDocument::MWAW_T_MACPAINT, 1, MWAWDocument::MWAW_K_PAINT},
+  {"MRSN", "RSGJ", MWAWDocument::MWAW_T_READYSETGO, 3, MWAWDocument::MWAW_K_DRAW},
+  {"MRSN", "RSGK", MWAWDocument::MWAW_T_READYSETGO, 4, MWAWDocument::MWAW_K_DRAW},
+  {"MSWD", "WDBN", MWAWDocument::MWAW_T_MICROSOFTWORD, 3, MWAWDocument::MWAW_K_TEXT},
+  {"MSWD", "GLOS", MWAWDocument::MWAW_T_MICROSOFTWORD, 3, MWAWDocument::MWAW_K_TEXT},
+  {"MSWK", "AWWP", MWAWDocument::MWAW_T_MICROSOFTWORKS, 3, MWAWDocument::MWAW_K_TEXT},
+  {"MSWK", "AWDB", MWAWDocument::MWAW_T_MICROSOFTWORKS, 3, MWAWDocument::MWAW_K_DATABASE},
+  {"MSWK", "AWDR", MWAWDocument::MWAW_T_MICROSOFTWORKS, 3, MWAWDocument::MWAW_K_DRAW},
+  {"MSWK", "AWSS", MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"MSWK", "RLRB", MWAWDocument::MWAW_T_MICROSOFTWORKS, 4, MWAWDocument::MWAW_K_TEXT},
+  {"MSWK", "sWRB", MWAWDocument::MWAW_T_MICROSOFTWORKS, 4, MWAWDocument::MWAW_K_TEXT},
+  {"MWII", "MW2D", MWAWDocument::MWAW_T_MACWRITEPRO, 0, MWAWDocument::MWAW_K_TEXT},
+  {"MWPR", "MWPd", MWAWDocument::MWAW_T_MACWRITEPRO, 1, MWAWDocument::MWAW_K_TEXT},
+  {"NISI", "TEXT", MWAWDocument::MWAW_T_NISUSWRITER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"NISI", "GLOS", MWAWDocument::MWAW_T_NISUSWRITER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"PANT", "PNTG", MWAWDocument::MWAW_T_FULLPAINT, 1, MWAWDocument::MWAW_K_PAINT},
+  {"PLAN", "MPBN", MWAWDocument::MWAW_T_MICROSOFTMULTIPLAN, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"PIXR", "PX01", MWAWDocument::MWAW_T_PIXELPAINT, 1, MWAWDocument::MWAW_K_DRAW},
+  {"PPT3", "SLD3", MWAWDocument::MWAW_T_POWERPOINT, 3, MWAWDocument::MWAW_K_PRESENTATION},
+  {"PPNT", "SLDS", MWAWDocument::MWAW_T_POWERPOINT, 2, MWAWDocument::MWAW_K_PRESENTATION},
+  {"PSIP", "AWWP", MWAWDocument::MWAW_T_MICROSOFTWORKS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"PSI2", "AWWP", MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_TEXT},
+  {"PSI2", "AWDB", MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_DATABASE},
+  {"PSI2", "AWSS", MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"PWRI", "OUTL", MWAWDocument::MWAW_T_MINDWRITE, 2, MWAWDocument::MWAW_K_TEXT},
+  {"Rslv", "RsWs", MWAWDocument::MWAW_T_CLARISRESOLVE, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"R#+A", "R#+D", MWAWDocument::MWAW_T_RAGTIME, 3, MWAWDocument::MWAW_K_TEXT},
+  {"R#+A", "R#+F", MWAWDocument::MWAW_T_RAGTIME, 3, MWAWDocument::MWAW_K_TEXT},
+  {"Spud", "SPUB", MWAWDocument::MWAW_T_SCOOP, 1, MWAWDocument::MWAW_K_DRAW},
+  {"SPNT", "SPTG", MWAWDocument::MWAW_T_SUPERPAINT, 1, MWAWDocument::MWAW_K_PAINT},
+  {"SPNT", "PNTG", MWAWDocument::MWAW_T_MACPAINT, 1, MWAWDocument::MWAW_K_PAINT},
+  {"StAV", "APPL", MWAWDocument::MWAW_T_STYLE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"St\xd8l", "TEd\xb6", MWAWDocument::MWAW_T_STYLE, 1, MWAWDocument::MWAW_K_TEXT}, // not standard characters
+  {"SWCM", "JRNL", MWAWDocument::MWAW_T_STUDENTWRITING, 1, MWAWDocument::MWAW_K_TEXT},
+  {"SWCM", "LTTR", MWAWDocument::MWAW_T_STUDENTWRITING, 1, MWAWDocument::MWAW_K_TEXT},
+  {"SWCM", "NWSL", MWAWDocument::MWAW_T_STUDENTWRITING, 1, MWAWDocument::MWAW_K_TEXT},
+  {"SWCM", "RPRT", MWAWDocument::MWAW_T_STUDENTWRITING, 1, MWAWDocument::MWAW_K_TEXT},
+  {"SWCM", "SIGN", MWAWDocument::MWAW_T_STUDENTWRITING, 1, MWAWDocument::MWAW_K_TEXT},
+  {"TBB5", "TEXT", MWAWDocument::MWAW_T_TEXEDIT, 1, MWAWDocument::MWAW_K_TEXT},
+  {"TBB5", "ttro", MWAWDocument::MWAW_T_TEXEDIT, 1, MWAWDocument::MWAW_K_TEXT},
+  {"WMkr", "Word", MWAWDocument::MWAW_T_WORDMAKER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"WMkr", "WSta", MWAWDocument::MWAW_T_WORDMAKER, 1, MWAWDocument::MWAW_K_TEXT},
+  {"WNGZ", "WZSS", MWAWDocument::MWAW_T_WINGZ, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"WORD", "WDBN", MWAWDocument::MWAW_T_MICROSOFTWORD, 1, MWAWDocument::MWAW_K_TEXT},
+  {"ZEBR", "ZWRT", MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_TEXT},
+  {"ZEBR", "ZOBJ", MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_DRAW},
+  {"ZEBR", "PNTG", MWAWDocument::MWAW_T_MACPAINT, 1, MWAWDocument::MWAW_K_PAINT},
+  {"ZEBR", "ZPNT", MWAWDocument::MWAW_T_GREATWORKS, 2, MWAWDocument::MWAW_K_PAINT},
+  {"ZEBR", "ZCAL", MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET},
+  {"ZEBR", "ZDBS", MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_DATABASE},
+  {"ZWRT", "Zart", MWAWDocument::MWAW_T_ZWRITE, 1, MWAWDocument::MWAW_K_TEXT},
+  {"aca3", "acf3", MWAWDocument::MWAW_T_FREEHAND, 1, MWAWDocument::MWAW_K_DRAW},
+  {"aca3", "act3", MWAWDocument::MWAW_T_FREEHAND, 1, MWAWDocument::MWAW_K_DRAW},
+  {"dPro", "dDoc", MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW},
+  {"dPro", "dLib", MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW},
+  {"eDcR", "eDoc", MWAWDocument::MWAW_T_EDOC, 1, MWAWDocument::MWAW_K_TEXT},
+  {"eSRD", "APPL", MWAWDocument::MWAW_T_EDOC, 1, MWAWDocument::MWAW_K_TEXT},
+  {"nX^n", "nX^d", MWAWDocument::MWAW_T_WRITENOW, 2, MWAWDocument::MWAW_K_TEXT},
+  {"nX^n", "nX^2", MWAWDocument::MWAW_T_WRITENOW, 3, MWAWDocument::MWAW_K_TEXT},
+  {"ttxt", "TEXT", MWAWDocument::MWAW_T_TEACHTEXT, 1, MWAWDocument::MWAW_K_TEXT},
+  {"ttxt", "ttro", MWAWDocument::MWAW_T_TEACHTEXT, 1, MWAWDocument::MWAW_K_TEXT},
+};
+
+//! returns a key corresponding to a 4 characters creator and type
+static uint64_t getFinderKey(char const *creator, char const *type)
+{
+  uint64_t res=0;
+  for (int i=0; i<4; ++i) res=(res<<8)|uint64_t(static_cast<unsigned char>(creator[i]));
+  for (int i=0; i<4; ++i) res=(res<<8)|uint64_t(static_cast<unsigned char>(type[i]));
+  return res;
+}
+
+//! returns the finder signature corresponding to a creator and a type if it exists
+static FinderSignature const *findFinderSignature(std::string const &creator, std::string const &type)
+{
+  if (creator.size()!=4 || type.size()!=4) return nullptr;
+  static std::unordered_map<uint64_t, FinderSignature const *> const s_keyToSignatureMap=[]() {
+    std::unordered_map<uint64_t, FinderSignature const *> map;
+    for (auto const &sig : s_finderSignatures)
+      map[getFinderKey(sig.m_creator, sig.m_type)]=&sig;
+    return map;
+  }();
+  auto it=s_keyToSignatureMap.find(getFinderKey(creator.c_str(), type.c_str()));
+  return it==s_keyToSignatureMap.end() ? nullptr : it->second;
+}
+
+/** a data fork signature: the file's first five big endian words
+    masked by m_mask must be equal to m_value */
+struct DataSignature {
+  //! the expected values
+  int m_value[5];
+  //! the masks
+  int m_mask[5];
+  //! the document type
+  MWAWDocument::Type m_docType;
+  //! the document version
+  int m_version;
+  //! the document kind
+  MWAWDocument::Kind m_docKind;
+  //! a name used for debugging
+  char const *m_name;
+  //! returns true if the signature matches the first five words
+  bool match(int const(&val)[5]) const
+  {
+    for (int i=0; i<5; ++i) {
+      if ((val[i]&m_mask[i])!=m_value[i])
+        return false;
+    }
+    return true;
+  }
+};
+
+/** the list of data fork signatures which are clearly discriminant,
+    sorted by first word.
+
+    \note the signatures which need to read more data or which can be
+    shared with other formats remain tested in constructHeader */
+static DataSignature const s_dataSignatures[]= {
+  {{0,0,0,0x70,0x1100}, {0xffff,0xffff,0xffff,0xffff,0xffff}, MWAWDocument::MWAW_T_SCOOP, 1, MWAWDocument::MWAW_K_DRAW, "Scoop"},
+  {{2,0,2,0x262,0x262}, {0xffff,0xffff,0xffff,0xffff,0xffff}, MWAWDocument::MWAW_T_MACDRAFT, 1, MWAWDocument::MWAW_K_DRAW, "MacDraft"},
+  {{3,0x4d52,0x4949,0x80,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_MORE, 2, MWAWDocument::MWAW_K_TEXT, "More 2"}, // MRII
+  {{6,0x4d4f,0x5233,0x80,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_MORE, 3, MWAWDocument::MWAW_K_TEXT, "More 3"}, // MOR3
+  {{0xc,0x1357,0x13,0,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_DRAWINGTABLE, 1, MWAWDocument::MWAW_K_DRAW, "Drawing Table"},
+  {{0xc,0x1357,0x14,0,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_DRAWINGTABLE, 1, MWAWDocument::MWAW_K_DRAW, "Drawing Table"},
+  {{0x100,0x5a57,0x5254,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_TEXT, "GreatWorks"},
+  {{0x100,0x5a4f,0x424a,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_DRAW, "GreatWorks Draw"},
+  {{0x100,0x5a43,0x414c,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET, "GreatWorks Spreadsheet"},
+  {{0x100,0x5a44,0x4253,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_DATABASE, "GreatWorks Database"},
+  // maybe we can also add outline: 0x5a4f,0x4c4e
+  {{0x200,0x5a57,0x5254,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 2, MWAWDocument::MWAW_K_TEXT, "GreatWorks"},
+  {{0x200,0x5a4f,0x424a,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 2, MWAWDocument::MWAW_K_DRAW, "GreatWorks Draw"},
+  {{0x200,0x5a43,0x414c,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 2, MWAWDocument::MWAW_K_SPREADSHEET, "GreatWorks Spreadsheet"},
+  {{0x200,0x5a44,0x4253,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_GREATWORKS, 2, MWAWDocument::MWAW_K_DATABASE, "GreatWorks Database"},
+  {{0x11ab,0,0x13e8,0,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_MICROSOFTMULTIPLAN, 1, MWAWDocument::MWAW_K_SPREADSHEET, "Multiplan"},
+  {{0x4241,0x545f,0x4254,0x5353,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_CLARISRESOLVE, 1, MWAWDocument::MWAW_K_SPREADSHEET, "ClarisResolve"},
+  {{0x4257,0x6b73,0x4257,0x7770,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_TEXT, "BeagleWorks"},
+  {{0x4257,0x6b73,0x4257,0x6462,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DATABASE, "BeagleWorks Database"},
+  {{0x4257,0x6b73,0x4257,0x6472,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DRAW, "BeagleWorks Draw"},
+  {{0x4257,0x6b73,0x4257,0x7074,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_PAINT, "BeagleWorks Paint"},
+  {{0x4257,0x6b73,0x4257,0x7373,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET, "BeagleWorks Spreadsheet"},
+  {{0x4323,0x2b44,0xa443,0x4da5,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_RAGTIME, 5, MWAWDocument::MWAW_K_TEXT, "RagTime 5-6"},
+  {{0x4452,0x5747,0x4d44,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_MACDRAW, 1, MWAWDocument::MWAW_K_DRAW, "MacDraw"}, // DRWGMD
+  {{0x4646,0x4646,0x3030,0x3030,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_MARINERWRITE, 1, MWAWDocument::MWAW_K_TEXT, "Mariner Write"},
+  {{0x4859,0x4c53,0x0210,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_HANMACWORDK, 1, MWAWDocument::MWAW_K_TEXT, "HanMac Word-K"},
+  {{0x5354,0x4154,0,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW, "MacDraw II template"},
+  {{0x5354,0x4154,0x4432,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW, "MacDraw II template"},
+  {{0x574e,0x475a,0x575a,0x5353,0}, {0xffff,0xffff,0xffff,0xffff,0}, MWAWDocument::MWAW_T_WINGZ, 1, MWAWDocument::MWAW_K_SPREADSHEET, "Wingz"},
+  {{0x594c,0x5953,0x100,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_HANMACWORDJ, 1, MWAWDocument::MWAW_K_TEXT, "HanMac Word-J"},
+#ifdef DEBUG
+  // we need the resource fork to find the colors, patterns, ... ; so not active in normal mode
+  {{0x6444,0x6f63,0x4432,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW, "MacDraw Pro"}, // dDocD2
+  {{0x644c,0x6962,0x4432,0,0}, {0xffff,0xffff,0xffff,0,0}, MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW, "MacDraw Pro template"}, // dLibD2
+#endif
+};
+
+//! small structure used to find the data signatures which begin by a word
+struct DataSignatureCompare {
+  //! comparison between a signature and a first word
+  bool operator()(DataSignature const &sig, int val) const
+  {
+    return sig.m_value[0]<val;
+  }
+  //! comparison between a first word and a signature
+  bool operator()(int val, DataSignature const &sig) const
+  {
+    return val<sig.m_value[0];
+  }
+};
+
+//! returns the data signature which matches the first five words if it exists
+static DataSignature const *findDataSignature(int const(&val)[5])
+{
+  auto range=std::equal_range(std::begin(s_dataSignatures), std::end(s_dataSignatures), val[0], DataSignatureCompare());
+  for (auto it=range.first; it!=range.second; ++it) {
+    if (it->match(val))
+      return &(*it);
+  }
+  return nullptr;
+}
+}
+
 MWAWHeader::MWAWHeader(MWAWDocument::Type documentType, int vers, MWAWDocument::Kind kind)
   : m_version(vers)
   , m_docType(documentType)
@@ -69,653 +362,10 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
   std::string type, creator;
   if (input->getFinderInfo(type, creator) && !creator.empty()) {
     // set basic version, the correct will be filled by check header
-    if (creator[0]=='A') {
-      if (creator=="ACTA") {
-        if (type=="OTLN") { // at least basic v2
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_ACTA, 1));
-          return res;
-        }
-        else if (type=="otln") {   // classic version
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_ACTA, 2));
-          return res;
-        }
-      }
-      else if (creator=="AISW") {
-        if (type=="SWDC" || type=="SWSP" || type=="SWWP") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_SCRIPTWRITER, 1));
-          return res;
-        }
-      }
-      else if (creator=="APBP") {
-        if (type=="APBL") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_DRAWINGTABLE, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="ARTX") { // Painter X
-        if (type=="RIFF") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CORELPAINTER, 10, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='B') {
-      if (creator=="BOBO") {
-        if (type=="CWDB" || type=="CWD2" || type=="sWDB") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DATABASE));
-          return res;
-        }
-        if (type=="CWGR" || type=="sWGR") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        if (type=="CWSS" || type=="CWS2" || type=="sWSS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-        if (type=="CWPR") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_PRESENTATION));
-          return res;
-        }
-        if (type=="CWPT") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-        if (type=="CWWP" || type=="CWW2" || type=="sWPP") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISWORKS, 1, MWAWDocument::MWAW_K_TEXT));
-          return res;
-        }
-      }
-      else if (creator=="BWks") {
-        if (type=="BWwp") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1));
-          return res;
-        }
-        if (type=="BWdb") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DATABASE));
-          return res;
-        }
-        if (type=="BWdr") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        if (type=="BWpt") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-        if (type=="BWss") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='C') {
-      if (creator=="CDrw") {
-        if (type=="dDrw" || type=="dDst" || type=="iLib") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISDRAW, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="CRDW") {
-        if (type=="CKDT") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CRICKETDRAW, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="C#+A") { // solo
-        if (type=="C#+D" || type=="C#+F") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_RAGTIME, 5));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='D') {
-      if (creator.substr(0,3)=="DAD") {
-        if (creator=="DAD2") {
-          if (type=="drw2") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 2, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-        }
-        else if (creator=="DAD5") {
-          if (type=="drw2") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 2, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-          if (type=="drw5" || type=="drwt") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 5, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-          if (type=="VINF") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 5, MWAWDocument::MWAW_K_PAINT));
-            return res;
-          }
-        }
-        else if (creator=="DAD6") {
-          if (type=="drw6" || type=="drwt") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 6, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-          if (type=="VINF") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 6, MWAWDocument::MWAW_K_PAINT));
-            return res;
-          }
-        }
-        else if (creator=="DAD7") {
-          if (type=="drw7" || type=="drwt") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-          if (type=="VINF") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_PAINT));
-            return res;
-          }
-        }
-        else if (creator=="DAD8") {
-          if (type=="drw8" || type=="drwt") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 8, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-          if (type=="VINF") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 8, MWAWDocument::MWAW_K_PAINT));
-            return res;
-          }
-        }
-        else if (creator=="DAD9" || creator=="DADX") {
-          if (type=="drwX" || type=="drwt") {
-            res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 9, MWAWDocument::MWAW_K_DRAW));
-            return res;
-          }
-        }
-      }
-      else if (creator=="Dc@P" || creator=="Dk@P") {
-        if (type=="APPL") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_DOCMAKER, 1));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='F') {
-      if (creator=="FHA2") {
-        if (type=="FHD2" || type=="FHT2") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FREEHAND, 2, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="FS03") {
-        if (type=="WRT+") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_WRITERPLUS, 1));
-          return res;
-        }
-      }
-      else if (creator=="FSPS" || creator=="FSDA") { // Fractal Design Painter or Dabbler
-        if (type=="RIFF") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CORELPAINTER, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-      }
-      else if (creator=="FSX3") {
-        if (type=="RIFF") { // also FSFS list of uncompressed picture data for movie
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CORELPAINTER, 3, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-      }
-      else if (creator=="FWRT") {
-        if (type=="FWRM") { // 1.7 ?
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FULLWRITE, 1));
-          return res;
-        }
-        if (type=="FWRT") { // 1.0 ?
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FULLWRITE, 1));
-          return res;
-        }
-        if (type=="FWRI") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FULLWRITE,2));
-          return res;
-        }
-      }
-      else if (creator=="F#+A") { // Classic
-        if (type=="F#+D" || type=="F#+F") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_RAGTIME, 3));
-          return res;
-        }
-      }
-    }
-    else if (creator=="GM01") {
-      if (type=="GfMt") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MOUSEWRITE, 1));
-        return res;
-      }
-    }
-    else if (creator=="HMiw") {   // japonese
-      if (type=="IWDC") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_HANMACWORDJ,1));
-        return res;
-      }
-    }
-    else if (creator=="HMdr") {   // korean
-      if (type=="DRD2") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_HANMACWORDK,1));
-        return res;
-      }
-    }
-    else if (creator=="JAZZ") {
-      if (type=="JWPD") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_JAZZLOTUS,1));
-        return res;
-      }
-      else if (type=="JWKS") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_JAZZLOTUS, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-        return res;
-      }
-      else if (type=="JDBS") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_JAZZLOTUS, 1, MWAWDocument::MWAW_K_DATABASE));
-        return res;
-      }
-    }
-    else if (creator[0]=='L') {
-      if (creator=="LMAN") {
-        if (type=="TEXT") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, 7, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="LWTE") {
-        if (type=="TEXT" || type=="ttro") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_LIGHTWAYTEXT,1));
-          return res;
-        }
-      }
-      else if (creator=="LWTR") {
-        if (type=="APPL") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_LIGHTWAYTEXT,1));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='M') {
-      if (creator=="MACA") {
-        if (type=="WORD") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACWRITE, 1));
-          return res;
-        }
-      }
-      else if (creator=="MACD") { // v1.0
-        if (type=="DRWG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAFT, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MART") {
-        if (type=="RSGF") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_READYSETGO, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        else if (type=="RSGI") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_READYSETGO, 2, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MAXW") {
-        if (type=="MWCT") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MAXWRITE, 1));
-          return res;
-        }
-      }
-      else if (creator=="MD40") {
-        if (type=="MDDC" || type=="MSYM") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAFT, 4, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MDFT") { // v1.2
-        if (type=="DRWG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAFT, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MDPL") { // MacDraw II
-        if (type=="DRWG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        if (type=="STAT") { // stationery
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MDRW") {
-        if (type=="DRWG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAW, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MDsr") {
-        if (type=="APPL") { // auto content
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDOC, 1));
-          return res;
-        }
-      }
-      else if (creator=="MDvr") {
-        if (type=="MDdc") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDOC, 1));
-          return res;
-        }
-      }
-      else if (creator=="MEMR") { // 4.5
-        if (type=="RSGR") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_READYSETGO, 5, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MMBB") {
-        if (type=="MBBT") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MARINERWRITE, 1));
-          return res;
-        }
-      }
-      else if (creator=="MORE") {
-        if (type=="MORE") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MORE, 1));
-          return res;
-        }
-      }
-      else if (creator=="MOR2") {
-        if (type=="MOR2") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MORE, 2));
-          return res;
-        }
-        if (type=="MOR3") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MORE, 3));
-          return res;
-        }
-      }
-      else if (creator=="MPNT") {
-        if (type=="PNTG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACPAINT, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-      }
-      else if (creator=="MRSN") {
-        if (type=="RSGJ") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_READYSETGO, 3, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        if (type=="RSGK") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_READYSETGO, 4, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="MSWD") {
-        if (type=="WDBN" || type=="GLOS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORD, 3));
-          return res;
-        }
-      }
-      else if (creator=="MSWK") {
-        if (type=="AWWP") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 3));
-          return res;
-        }
-        if (type=="AWDB") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 3, MWAWDocument::MWAW_K_DATABASE));
-          return res;
-        }
-        if (type=="AWDR") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 3, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        if (type=="AWSS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-        if (type=="RLRB" || type=="sWRB") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 4));
-          return res;
-        }
-      }
-      else if (creator=="MWII") {   // MacWriteII
-        if (type=="MW2D") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACWRITEPRO, 0));
-          return res;
-        }
-      }
-      else if (creator=="MWPR") {
-        if (type=="MWPd") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACWRITEPRO, 1));
-          return res;
-        }
-      }
-    }
-    else if (creator=="NISI") {
-      if (type=="TEXT") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_NISUSWRITER, 1));
-        return res;
-      }
-      if (type=="GLOS") { // checkme: glossary, ie. a list of picture/word, keep it ?
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_NISUSWRITER, 1));
-        return res;
-      }
-      // "edtt": empty file, probably created when the file is edited
-    }
-    else if (creator[0]=='P') {
-      if (creator=="PANT") {
-        if (type=="PNTG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FULLPAINT, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-      }
-      else if (creator=="PLAN") {
-        if (type=="MPBN") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTMULTIPLAN, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-      }
-      else if (creator=="PIXR") {
-        if (type=="PX01") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_PIXELPAINT, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="PPT3") {
-        if (type=="SLD3") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_POWERPOINT, 3, MWAWDocument::MWAW_K_PRESENTATION));
-          return res;
-        }
-      }
-      else if (creator=="PPNT") {
-        if (type=="SLDS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_POWERPOINT, 2, MWAWDocument::MWAW_K_PRESENTATION));
-          return res;
-        }
-      }
-      else if (creator=="PSIP") {
-        if (type=="AWWP") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 1));
-          return res;
-        }
-      }
-      else if (creator=="PSI2") {
-        if (type=="AWWP") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 2));
-          return res;
-        }
-        if (type=="AWDB") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_DATABASE));
-          return res;
-        }
-        if (type=="AWSS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORKS, 2, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-      }
-      else if (creator=="PWRI") {
-        if (type=="OUTL") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MINDWRITE, 2));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='R') {
-      if (creator=="Rslv") {
-        if (type=="RsWs") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISRESOLVE, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-      }
-      else if (creator=="R#+A") {
-        if (type=="R#+D" || type=="R#+F") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_RAGTIME, 3));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='S') {
-      if (creator=="Spud") {
-        if (type=="SPUB") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_SCOOP, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-      }
-      else if (creator=="SPNT") {
-        if (type=="SPTG") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_SUPERPAINT, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-        if (type=="PNTG") {
-          // same as MacPaint format, so use the MacPaint parser
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACPAINT, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-        // other type seems to correspond to basic picture file, so we do not accept them
-      }
-      else if (creator=="StAV") {
-        if (type=="APPL") { // Style: document application
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_STYLE, 1));
-          return res;
-        }
-      }
-      else if (creator==std::string("St")+'\xd8'+"l") { //  argh, not standart character
-        std::string type1=std::string("TEd")+'\xb6'; // argh, not standart character
-        if (type==type1) {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_STYLE, 1));
-          return res;
-        }
-      }
-      else if (creator=="SWCM") {
-        if (type=="JRNL" || type=="LTTR" || type=="NWSL" || type=="RPRT" || type=="SIGN") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_STUDENTWRITING, 1));
-          return res;
-        }
-      }
-    }
-    else if (creator=="TBB5") {
-      if (type=="TEXT" || type=="ttro") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_TEXEDIT, 1));
-        return res;
-      }
-    }
-    else if (creator[0]=='W') {
-      if (creator=="WMkr") {
-        if (type=="Word" || type=="WSta") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_WORDMAKER, 1));
-          return res;
-        }
-      }
-      else if (creator=="WNGZ") {
-        if (type=="WZSS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_WINGZ, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-      }
-      else if (creator=="WORD") {
-        if (type=="WDBN") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTWORD, 1));
-          return res;
-        }
-      }
-    }
-    else if (creator[0]=='Z') {
-      if (creator=="ZEBR") {
-        if (type=="ZWRT") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, 1));
-          return res;
-        }
-        if (type=="ZOBJ") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_DRAW));
-          return res;
-        }
-        if (type=="PNTG") {
-          // same as MacPaint format, so use the MacPaint parser
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACPAINT, 1, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-        if (type=="ZPNT") {
-          /* the ZPNT(v2) are basic pct files with some resources, but
-             we treat them to be complete */
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, 2, MWAWDocument::MWAW_K_PAINT));
-          return res;
-        }
-        if (type=="ZCAL") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-          return res;
-        }
-        if (type=="ZDBS") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, 1, MWAWDocument::MWAW_K_DATABASE));
-          return res;
-        }
-        // can we treat also ZOLN ?
-      }
-      else if (creator=="ZWRT") {
-        if (type=="Zart") {
-          res.push_back(MWAWHeader(MWAWDocument::MWAW_T_ZWRITE, 1));
-          return res;
-        }
-      }
-    }
-    else if (creator=="aca3") {
-      if (type=="acf3" || type=="act3") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FREEHAND, 1, MWAWDocument::MWAW_K_DRAW));
-        return res;
-      }
-    }
-    else if (creator=="dPro") {
-      if (type=="dDoc") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW));
-        return res;
-      }
-      if (type=="dLib") { // macdraw pro slide/library
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW));
-        return res;
-      }
-    }
-    else if (creator=="eDcR") {
-      if (type=="eDoc") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_EDOC, 1));
-        return res;
-      }
-    }
-    else if (creator=="eSRD") {   // self reading application
-      if (type=="APPL") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_EDOC, 1));
-        return res;
-      }
-    }
-    else if (creator=="nX^n") {
-      if (type=="nX^d") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_WRITENOW, 2));
-        return res;
-      }
-      if (type=="nX^2") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_WRITENOW, 3));
-        return res;
-      }
-    }
-    else if (creator=="ttxt") {
-      if (type=="TEXT" || type=="ttro") {
-        res.push_back(MWAWHeader(MWAWDocument::MWAW_T_TEACHTEXT, 1));
-        return res;
-      }
+    auto const *sig=MWAWHeaderInternal::findFinderSignature(creator, type);
+    if (sig) {
+      res.push_back(MWAWHeader(sig->m_docType, sig->m_version, sig->m_docKind));
+      return res;
     }
     // check also basic type
     if (type=="PICT") {
@@ -736,6 +386,12 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
   for (auto &v : val) v = int(input->readULong(2));
 
   // ----------- clearly discriminant ------------------
+  auto const *dataSig=MWAWHeaderInternal::findDataSignature(val);
+  if (dataSig) {
+    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a %s file\n", dataSig->m_name));
+    res.push_back(MWAWHeader(dataSig->m_docType, dataSig->m_version, dataSig->m_docKind));
+    return res;
+  }
   if (val[2] == 0x424F && val[3] == 0x424F && (val[0]>>8) < 7) {
     MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a Claris Works file\n"));
     int vers= (val[0] >> 8);
@@ -787,69 +443,7 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
       return res;
     }
   }
-  if (val[0]==0x574e && val[1]==0x475a && val[2]==0x575a && val[3]==0x5353) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a Wingz file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_WINGZ, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-    return res;
-  }
-  if (val[0]==0x4241 && val[1]==0x545F && val[2]==0x4254 && val[3]==0x5353) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a ClarisResolve file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISRESOLVE, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-    return res;
-  }
-  if (val[0]==0x4323 && val[1]==0x2b44 && val[2]==0xa443 && val[3]==0x4da5) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a RagTime 5-6 file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_RAGTIME, 5));
-    return res;
-  }
-  if (val[0]==0x4646 && val[1]==0x4646 && val[2]==0x3030 && val[3]==0x3030) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a Mariner Write file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MARINERWRITE, 1));
-    return res;
-  }
-  if (val[0]==0x000c && val[1]==0x1357 && (val[2]==0x13 || val[2]==0x14) && val[3]==0) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a Drawing Table file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_DRAWINGTABLE, 1, MWAWDocument::MWAW_K_DRAW));
-    return res;
-  }
-  if (val[0]==0x4257 && val[1]==0x6b73 && val[2]==0x4257) {
-    if (val[3]==0x7770) {
-      MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a BeagleWorks file\n"));
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1));
-      return res;
-    }
-    if (val[3]==0x6462) {
-      MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a BeagleWorks Database file\n"));
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DATABASE));
-      return res;
-    }
-    if (val[3]==0x6472) {
-      MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a BeagleWorks Draw file\n"));
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_DRAW));
-      return res;
-    }
-    if (val[3]==0x7074) {
-      MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a BeagleWorks Paint file\n"));
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_PAINT));
-      return res;
-    }
-    if (val[3]==0x7373) {
-      MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a BeagleWorks Spreadsheet file\n"));
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_BEAGLEWORKS, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-      return res;
-    }
-  }
-  if (val[0]==0 && val[1]==0 && val[2]==0 && val[3]==0x70 && val[4]==0x1100) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a Scoop file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_SCOOP, 1, MWAWDocument::MWAW_K_DRAW));
-    return res;
-  }
   if (val[0]==0x4452 && val[1]==0x5747) { // DRWG
-    if (val[2]==0x4d44) { // MD
-      MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacDraw file\n"));
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAW, 1, MWAWDocument::MWAW_K_DRAW));
-      return res;
-    }
     if (val[2]==0 || val[2]==0x4432) { // D2
       MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacDraw II file\n"));
       res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW));
@@ -860,24 +454,6 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
     MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a Student Writing Center file\n"));
     res.push_back(MWAWHeader(MWAWDocument::MWAW_T_STUDENTWRITING, 1));
   }
-  if (val[0]==0x5354 && val[1]==0x4154 && (val[2]==0 || val[2]==0x4432)) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacDraw II template file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 0, MWAWDocument::MWAW_K_DRAW));
-    return res;
-  }
-#ifdef DEBUG
-  // we need the resource fork to find the colors, patterns, ... ; so not active in normal mode
-  if (val[0]==0x6444 && val[1]==0x6f63 && val[2]==0x4432) { // dDocD2
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacDraw Pro file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW));
-    return res;
-  }
-  if (val[0]==0x644c && val[1]==0x6962 && val[2]==0x4432) { // dLibD2
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacDraw Pro template file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAWPRO, 1, MWAWDocument::MWAW_K_DRAW));
-    return res;
-  }
-#endif
   // Canvas
   if (val[0]==0x200 && val[1]==0x80) {
     if (val[2]==0 && val[3]==0 && (val[4]>>8)<=8 && (val[4]&0xff)==0) {
@@ -933,21 +509,6 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
     }
     res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CANVAS, val[1]==1 ? 5 : 9, MWAWDocument::MWAW_K_PAINT));
   }
-  if (val[0]==2 && val[1]==0 && val[2]==2 && val[3]==0x262 && val[4]==0x262) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a MacDraft file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAFT, 1, MWAWDocument::MWAW_K_DRAW));
-    return res;
-  }
-  if (val[0]==0x4859 && val[1]==0x4c53 && val[2]==0x0210) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a HanMac Word-K file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_HANMACWORDK, 1));
-    return res;
-  }
-  if (val[0]==0x594c && val[1]==0x5953 && val[2]==0x100) {
-    MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a HanMac Word-J file\n"));
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_HANMACWORDJ, 1));
-    return res;
-  }
   if (val[0]==0x6163 && val[1]==0x6633 && val[2]<9) {
     MWAW_DEBUG_MSG(("MWAWHeader::constructHeader: find a FreeHand v1\n"));
     res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FREEHAND, 1, MWAWDocument::MWAW_K_DRAW));
@@ -958,42 +519,11 @@ std::vector<MWAWHeader> MWAWHeader::constructHeader
     res.push_back(MWAWHeader(MWAWDocument::MWAW_T_FREEHAND, 2, MWAWDocument::MWAW_K_DRAW));
     return res;
   }
-  if (val[0]==3 && val[1]==0x4d52 && val[2]==0x4949 && val[3]==0x80) { // MRII
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MORE, 2));
-    return res;
-  }
-  if (val[0]==6 && val[1]==0x4d4f && val[2]==0x5233 && val[3]==0x80) { // MOR3
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MORE, 3));
-    return res;
-  }
   if ((val[0]==0x100||val[0]==0x200) && val[2]==0x4558 && val[3]==0x5057) { // CHANGEME: ClarisDraw
     res.push_back(MWAWHeader(MWAWDocument::MWAW_T_CLARISDRAW, 1, MWAWDocument::MWAW_K_DRAW));
     return res;
   }
 
-  if (val[0]==0x100 || val[0]==0x200) {
-    if (val[1]==0x5a57 && val[2]==0x5254) {
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, val[0]==0x100 ? 1 : 2));
-      return res;
-    }
-    if (val[1]==0x5a4f && val[2]==0x424a) {
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, val[0]==0x100 ? 1 : 2, MWAWDocument::MWAW_K_DRAW));
-      return res;
-    }
-    if (val[1]==0x5a43 && val[2]==0x414C) {
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, val[0]==0x100 ? 1 : 2, MWAWDocument::MWAW_K_SPREADSHEET));
-      return res;
-    }
-    if (val[1]==0x5a44 && val[2]==0x4253) {
-      res.push_back(MWAWHeader(MWAWDocument::MWAW_T_GREATWORKS, val[0]==0x100 ? 1 : 2, MWAWDocument::MWAW_K_DATABASE));
-      return res;
-    }
-    // maybe we can also add outline: if (val[1]==0x5a4f && val[2]==0x4c4e)
-  }
-  if (val[0]==0x11ab && val[1]==0 && val[2]==0x13e8 && val[3]==0) {
-    res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MICROSOFTMULTIPLAN, 1, MWAWDocument::MWAW_K_SPREADSHEET));
-    return res;
-  }
   if (val[3]==6 && val[4]<6) {
     if (val[0]==0x4d44 && val[1]==0x4443 && val[2]==0x3230) {
       res.push_back(MWAWHeader(MWAWDocument::MWAW_T_MACDRAFT, 4, MWAWDocument::MWAW_K_DRAW));
@@ -36,18 +36,29 @@
 #include <limits>
 #include <cmath>
 #include <cstring>
+#include <type_traits>
 
 #include <librevenge-stream/librevenge-stream.h>
 #include <librevenge/librevenge.h>
 
 #include "MWAWDebug.hxx"
 
+#include "MWAWBinHexStream.hxx"
 #include "MWAWInputStream.hxx"
+#include "MWAWMappedStream.hxx"
 #include "MWAWStringStream.hxx"
 
 MWAWInputStream::MWAWInputStream(std::shared_ptr<librevenge::RVNGInputStream> inp, bool inverted)
   : m_stream(inp)
   , m_streamSize(0)
+  , m_streamOffset(0)
+  , m_sliceLength(-1)
+  , m_readPos(0)
+  , m_windowData(nullptr)
+  , m_windowBuffer()
+  , m_windowBegin(0)
+  , m_windowEnd(0)
+  , m_windowIsMapped(false)
   , m_readLimit(-1)
   , m_prevLimits()
   , m_fInfoType("")
@@ -55,12 +66,22 @@ MWAWInputStream::MWAWInputStream(std::shared_ptr<librevenge::RVNGInputStream> in
   , m_resourceFork()
   , m_inverseRead(inverted)
 {
+  if (m_stream)
+    m_readPos=m_stream->tell();
   updateStreamSize();
 }
 
 MWAWInputStream::MWAWInputStream(librevenge::RVNGInputStream *inp, bool inverted, bool checkCompression)
   : m_stream()
   , m_streamSize(0)
+  , m_streamOffset(0)
+  , m_sliceLength(-1)
+  , m_readPos(0)
+  , m_windowData(nullptr)
+  , m_windowBuffer()
+  , m_windowBegin(0)
+  , m_windowEnd(0)
+  , m_windowIsMapped(false)
   , m_readLimit(-1)
   , m_prevLimits()
   , m_fInfoType("")
@@ -71,6 +92,7 @@ MWAWInputStream::MWAWInputStream(librevenge::RVNGInputStream *inp, bool inverted
   if (!inp) return;
 
   m_stream = std::shared_ptr<librevenge::RVNGInputStream>(inp, MWAW_shared_ptr_noop_deleter<librevenge::RVNGInputStream>());
+  m_readPos=m_stream->tell();
   updateStreamSize();
   if (!checkCompression)
     return;
@@ -119,6 +141,43 @@ std::shared_ptr<MWAWInputStream> MWAWInputStream::get(librevenge::RVNGBinaryData
   return res;
 }
 
+std::shared_ptr<MWAWInputStream> MWAWInputStream::slice(long begin, long end)
+{
+  std::shared_ptr<MWAWInputStream> res;
+  if (!m_stream || begin<0 || end<begin || end>m_streamSize) {
+    MWAW_DEBUG_MSG(("MWAWInputStream::slice: the limits %ld-%ld seem bad\n", begin, end));
+    return res;
+  }
+  res.reset(new MWAWInputStream(m_stream, m_inverseRead));
+  res->m_streamOffset=m_streamOffset+begin;
+  res->m_sliceLength=end-begin;
+  res->m_readPos=0;
+  res->updateStreamSize();
+  return res;
+}
+
+std::shared_ptr<MWAWInputStream> MWAWInputStream::copyCursor() const
+{
+  std::shared_ptr<MWAWInputStream> res;
+  if (!m_windowIsMapped)
+    return res;
+  std::shared_ptr<MWAWInputStream> rsrc;
+  if (m_resourceFork) {
+    rsrc=m_resourceFork->copyCursor();
+    if (!rsrc)
+      return res;
+  }
+  res.reset(new MWAWInputStream(m_stream, m_inverseRead));
+  res->m_streamOffset=m_streamOffset;
+  res->m_sliceLength=m_sliceLength;
+  res->m_readPos=0;
+  res->updateStreamSize();
+  res->m_fInfoType=m_fInfoType;
+  res->m_fInfoCreator=m_fInfoCreator;
+  res->m_resourceFork=rsrc;
+  return res;
+}
+
 void MWAWInputStream::recomputeStreamSize()
 {
   m_streamSize=0;
@@ -127,13 +186,31 @@ void MWAWInputStream::recomputeStreamSize()
 
 void MWAWInputStream::updateStreamSize()
 {
-  if (!m_stream)
+  resetWindow();
+  if (!m_stream) {
     m_streamSize=0;
+    return;
+  }
+  // if the file is mapped in memory, we can use directly its data
+  auto const *mappedStream=dynamic_cast<MWAWMappedStream const *>(m_stream.get());
+  bool isMapped=mappedStream && mappedStream->isValid();
+  long totalSize;
+  if (isMapped) // do not modify the stream position, its data can be shared between threads
+    totalSize=long(mappedStream->dataSize());
   else {
-    long actPos = tell();
     m_stream->seek(0, librevenge::RVNG_SEEK_END);
-    m_streamSize=tell();
-    m_stream->seek(actPos, librevenge::RVNG_SEEK_SET);
+    totalSize=m_stream->tell();
+  }
+  m_streamSize=totalSize;
+  if (m_sliceLength>=0) {
+    m_streamSize=totalSize>m_streamOffset ? totalSize-m_streamOffset : 0;
+    if (m_streamSize>m_sliceLength)
+      m_streamSize=m_sliceLength;
+  }
+  if (isMapped) {
+    m_windowData=mappedStream->data()+m_streamOffset;
+    m_windowEnd=m_streamSize;
+    m_windowIsMapped=true;
   }
 }
 
@@ -141,14 +218,35 @@ const uint8_t *MWAWInputStream::read(size_t numBytes, unsigned long &numBytesRea
 {
   if (!hasDataFork())
     throw libmwaw::FileException();
-  return m_stream->read(numBytes,numBytesRead);
+  numBytesRead=0;
+  if (m_windowIsMapped) {
+    if (numBytes==0 || m_readPos>=m_windowEnd)
+      return nullptr;
+    auto remain=static_cast<unsigned long>(m_windowEnd-m_readPos);
+    numBytesRead=numBytes<remain ? static_cast<unsigned long>(numBytes) : remain;
+    auto const *res=m_windowData+m_readPos;
+    m_readPos+=long(numBytesRead);
+    return res;
+  }
+  if (m_sliceLength>=0) { // do not read after the end of the slice
+    if (m_readPos>=m_streamSize)
+      return nullptr;
+    if (long(numBytes)>m_streamSize-m_readPos)
+      numBytes=size_t(m_streamSize-m_readPos);
+  }
+  // the returned pointer must stay valid until the next call to read, so bypass the read window
+  if (m_stream->seek(m_streamOffset+m_readPos, librevenge::RVNG_SEEK_SET)!=0)
+    return nullptr;
+  auto const *res=m_stream->read(numBytes,numBytesRead);
+  m_readPos+=long(numBytesRead);
+  return res;
 }
 
 long MWAWInputStream::tell()
 {
   if (!hasDataFork())
     return 0;
-  return m_stream->tell();
+  return m_readPos;
 }
 
 int MWAWInputStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
@@ -171,59 +269,90 @@ int MWAWInputStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
   if (offset > size())
     offset = size();
 
-  return m_stream->seek(offset, librevenge::RVNG_SEEK_SET);
+  m_readPos=offset;
+  return 0;
 }
 
 bool MWAWInputStream::isEnd()
 {
   if (!hasDataFork())
     return true;
-  long pos = m_stream->tell();
-  if (m_readLimit > 0 && pos >= m_readLimit) return true;
-  if (pos >= size()) return true;
+  if (m_readLimit > 0 && m_readPos >= m_readLimit) return true;
+  return m_readPos >= size();
+}
 
-  return m_stream->isEnd();
+long MWAWInputStream::fillWindow(long pos, long numBytes)
+{
+  if (pos>=m_windowBegin && pos+numBytes<=m_windowEnd)
+    return numBytes;
+  if (m_windowIsMapped) // the window already contains all the data
+    return pos>=m_windowBegin && pos<m_windowEnd ? m_windowEnd-pos : 0;
+  resetWindow();
+  if (!m_stream || pos<0 || pos>=m_streamSize)
+    return 0;
+  // read a block of s_windowSize bytes if possible, but do not look after the end of the stream
+  static long const s_windowSize=0x4000;
+  long toRead=numBytes>s_windowSize ? numBytes : s_windowSize;
+  if (toRead>m_streamSize-pos)
+    toRead=m_streamSize-pos;
+  if (m_stream->seek(m_streamOffset+pos, librevenge::RVNG_SEEK_SET)!=0)
+    return 0;
+  unsigned long numRead;
+  uint8_t const *p=m_stream->read(static_cast<unsigned long>(toRead), numRead);
+  if (!p || numRead==0)
+    return 0;
+  if (m_windowBuffer.size()<size_t(numRead))
+    m_windowBuffer.resize(size_t(numRead));
+  std::memcpy(m_windowBuffer.data(), p, size_t(numRead));
+  m_windowData=m_windowBuffer.data();
+  m_windowBegin=pos;
+  m_windowEnd=pos+long(numRead);
+  return numBytes<long(numRead) ? numBytes : long(numRead);
 }
 
-unsigned long MWAWInputStream::readULong(librevenge::RVNGInputStream *stream, int num, unsigned long a, bool inverseRead)
+unsigned long MWAWInputStream::readULongInWindow(int num)
 {
-  if (!stream || num <= 0 || stream->isEnd()) return a;
+  if (!hasDataFork() || num <= 0 || m_readPos>=m_streamSize) return 0;
   if (num > 8) { // reading more than 8 bytes does not make any sense, ...
     MWAW_DEBUG_MSG(("MWAWInputStream::readULong: argh called with %d bytes, resets it to 8 bytes\n", num));
     num = 8;
   }
-  else if (num > 4) { // normally, must be (not recursively) called with 1,2,4 bytes, so...
+  else if (num > 4) { // normally, must be called with 1,2,4 bytes, so...
     MWAW_DEBUG_MSG(("MWAWInputStream::readULong: argh called with %d bytes\n", num));
   }
-  if (inverseRead) {
-    unsigned long val = readU8(stream);
-    return val + (readULong(stream, num-1,0, inverseRead) << 8);
+  long numRead=fillWindow(m_readPos, num);
+  if (numRead<=0)
+    return 0;
+  unsigned char const *p=m_windowData+(m_readPos-m_windowBegin);
+  m_readPos+=numRead;
+  if (numRead!=num) // the end of stream is reached
+    return m_inverseRead ? decodeULong(p, int(numRead), true) : 0;
+  return decodeULong(p, num, m_inverseRead);
+}
+
+unsigned long MWAWInputStream::readULong(librevenge::RVNGInputStream *stream, int num, unsigned long a, bool inverseRead)
+{
+  if (!stream || num <= 0 || stream->isEnd()) return a;
+  if (num > 8) { // reading more than 8 bytes does not make any sense, ...
+    MWAW_DEBUG_MSG(("MWAWInputStream::readULong: argh called with %d bytes, resets it to 8 bytes\n", num));
+    num = 8;
   }
-  switch (num) {
-  case 4:
-  case 2:
-  case 1: {
-    unsigned long numBytesRead;
-    uint8_t const *p = stream->read(static_cast<unsigned long>(num), numBytesRead);
-    if (!p || int(numBytesRead) != num)
-      return 0;
-    switch (num) {
-    case 4:
-      return static_cast<unsigned long>(p[3])|(static_cast<unsigned long>(p[2])<<8)|
-             (static_cast<unsigned long>(p[1])<<16)|(static_cast<unsigned long>(p[0])<<24)|((a<<16)<<16);
-    case 2:
-      return (static_cast<unsigned long>(p[1]))|(static_cast<unsigned long>(p[0])<<8)|(a<<16);
-    case 1:
-      return (static_cast<unsigned long>(p[0]))|(a<<8);
-    default:
-      break;
-    }
-    break;
+  else if (num > 4) { // normally, must be called with 1,2,4 bytes, so...
+    MWAW_DEBUG_MSG(("MWAWInputStream::readULong: argh called with %d bytes\n", num));
   }
-  default:
-    return readULong(stream, num-1,(a<<8) + static_cast<unsigned long>(readU8(stream)), inverseRead);
+  unsigned long numBytesRead;
+  uint8_t const *p = stream->read(static_cast<unsigned long>(num), numBytesRead);
+  if (!p || numBytesRead==0)
+    return a;
+  if (int(numBytesRead) != num) // the end of stream is reached
+    return inverseRead ? decodeULong(p, int(numBytesRead), true) : 0;
+  unsigned long res=decodeULong(p, num, inverseRead);
+  if (a && !inverseRead) {
+    for (int i=0; i<num; ++i)
+      a<<=8;
+    res|=a;
   }
-  return 0;
+  return res;
 }
 
 long MWAWInputStream::readLong(int num)
@@ -254,22 +383,20 @@ uint8_t MWAWInputStream::readU8(librevenge::RVNGInputStream *stream)
   return *p;
 }
 
-bool MWAWInputStream::readDouble8(double &res, bool &isNotANumber)
+namespace MWAWInputStreamInternal
+{
+//! decodes a double of size 8 stored in p: 1.5 bytes exponent, 6.5 bytes mantisse
+static bool decodeDouble8(unsigned char const *p, double &res, bool &isNotANumber)
 {
-  if (!m_stream) return false;
-  long pos=tell();
-  if (m_readLimit > 0 && pos+8 > m_readLimit) return false;
-  if (pos+8 > m_streamSize) return false;
-
   isNotANumber=false;
   res=0;
-  auto mantExp=int(readULong(1));
-  auto val=static_cast<int>(readULong(1));
+  auto mantExp=int(p[0]);
+  auto val=static_cast<int>(p[1]);
   int exp=(mantExp<<4)+(val>>4);
   double mantisse=double(val&0xF)/16.;
   double factor=1./16/256.;
   for (int j = 0; j < 6; ++j, factor/=256)
-    mantisse+=double(readULong(1))*factor;
+    mantisse+=double(p[j+2])*factor;
   int sign = 1;
   if (exp & 0x800) {
     exp &= 0x7ff;
@@ -295,6 +422,106 @@ bool MWAWInputStream::readDouble8(double &res, bool &isNotANumber)
     res *= -1.;
   return true;
 }
+}
+
+bool MWAWInputStream::readDouble8(double &res, bool &isNotANumber)
+{
+  if (!m_stream) return false;
+  long pos=tell();
+  if (m_readLimit > 0 && pos+8 > m_readLimit) return false;
+  if (pos+8 > m_streamSize) return false;
+  if (fillWindow(pos, 8)<8) return false;
+  unsigned char const *p=m_windowData+(pos-m_windowBegin);
+  m_readPos+=8;
+  return MWAWInputStreamInternal::decodeDouble8(p, res, isNotANumber);
+}
+
+template <typename T> bool MWAWInputStream::readArray(T *res, size_t n)
+{
+  if (n==0) return true;
+  if (!res || !hasDataFork()) return false;
+  static size_t const sz=sizeof(T);
+  if (n > size_t(m_streamSize)/sz) return false;
+  long endPos=m_readPos+long(n*sz);
+  if ((m_readLimit > 0 && endPos > m_readLimit) || endPos > m_streamSize) return false;
+  typedef typename std::make_unsigned<T>::type U;
+  // read at most a window of data at each step
+  static size_t const maxChunk=0x4000/sz;
+  long const begPos=m_readPos;
+  while (n) {
+    size_t numElts=n<maxChunk ? n : maxChunk;
+    long numRead=fillWindow(m_readPos, long(numElts*sz));
+    if (numRead<long(sz)) {
+      m_readPos=begPos;
+      return false;
+    }
+    if (size_t(numRead)<numElts*sz)
+      numElts=size_t(numRead)/sz;
+    unsigned char const *p=m_windowData+(m_readPos-m_windowBegin);
+    // note: the loops are kept simple so that the compiler can unroll and vectorize them
+    if (m_inverseRead) {
+      for (size_t i=0; i<numElts; ++i, p+=sz) {
+        U val=0;
+        for (size_t j=sz; j>0; --j) val=U(U(val<<8)|p[j-1]);
+        res[i]=T(val);
+      }
+    }
+    else {
+      for (size_t i=0; i<numElts; ++i, p+=sz) {
+        U val=0;
+        for (size_t j=0; j<sz; ++j) val=U(U(val<<8)|p[j]);
+        res[i]=T(val);
+      }
+    }
+    res+=numElts;
+    n-=numElts;
+    m_readPos+=long(numElts*sz);
+  }
+  return true;
+}
+
+bool MWAWInputStream::readU16Array(uint16_t *res, size_t n)
+{
+  return readArray(res, n);
+}
+
+bool MWAWInputStream::readS16Array(int16_t *res, size_t n)
+{
+  return readArray(res, n);
+}
+
+bool MWAWInputStream::readU32Array(uint32_t *res, size_t n)
+{
+  return readArray(res, n);
+}
+
+bool MWAWInputStream::readS32Array(int32_t *res, size_t n)
+{
+  return readArray(res, n);
+}
+
+bool MWAWInputStream::readDouble8Array(double *res, size_t n)
+{
+  if (n==0) return true;
+  if (!res || !hasDataFork()) return false;
+  if (n > size_t(m_streamSize)/8) return false;
+  long endPos=m_readPos+long(8*n);
+  if ((m_readLimit > 0 && endPos > m_readLimit) || endPos > m_streamSize) return false;
+  bool ok=true, isNan;
+  long const begPos=m_readPos;
+  for (size_t i=0; i<n; ++i) {
+    if (fillWindow(m_readPos, 8)<8) {
+      m_readPos=begPos;
+      return false;
+    }
+    if (!MWAWInputStreamInternal::decodeDouble8(m_windowData+(m_readPos-m_windowBegin), res[i], isNan)) {
+      res[i]=0;
+      ok=false;
+    }
+    m_readPos+=8;
+  }
+  return ok;
+}
 
 bool MWAWInputStream::readDouble10(double &res, bool &isNotANumber)
 {
@@ -411,105 +638,35 @@ bool MWAWInputStream::unBinHex()
   if (isEnd() || !numEOL || (char(readLong(1)))!= ':')
     return false;
 
-  // first phase reconstruct the file
-  static char const binChar[65] = "!\"#$%&'()*+,-012345689@ABCDEFGHIJKLMNPQRSTUVXYZ[`abcdefhijklmpqr";
-  std::map<unsigned char,int>  binMap;
-  for (int i = 0; i < 64; i++) binMap[static_cast<unsigned char>(binChar[i])]=i;
-  bool endData = false;
-  int numActByte = 0, actVal = 0;
-  librevenge::RVNGBinaryData content;
-  bool findRepetitif = false;
-  while (1) {
-    if (isEnd()) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: do not find ending ':' character\n"));
-      return false;
-    }
-    auto c = static_cast<unsigned char>(readLong(1));
-    if (c == '\n') continue;
-    int readVal = 0;
-    if (c == ':')
-      endData = true;
-    else if (binMap.find(c) == binMap.end()) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find unexpected char when decoding file\n"));
-      return false;
-    }
-    else
-      readVal = binMap.find(c)->second;
-    int wVal = -1;
-    if (numActByte==0)
-      actVal |= (readVal<<2);
-    else if (numActByte==2) {
-      wVal = (actVal | readVal);
-      actVal = 0;
-    }
-    else if (numActByte==4) {
-      wVal = actVal | ((readVal>>2)&0xF);
-      actVal = (readVal&0x3)<<6;
-    }
-    else if (numActByte==6) {
-      wVal = actVal | ((readVal>>4)&0x3);
-      actVal = (readVal&0xf)<<4;
-    }
-    numActByte = (numActByte+6)%8;
-
-    int maxToWrite = (endData&&actVal) ? 2 : 1;
-    for (int wPos = 0; wPos < maxToWrite; wPos++) {
-      int value = wPos ? actVal : wVal;
-      if (value == -1) continue;
-      if (!findRepetitif && value != 0x90) {
-        content.append(static_cast<unsigned char>(value));
-        continue;
-      }
-      if (value == 0x90 && !findRepetitif) {
-        findRepetitif = true;
-        continue;
-      }
-
-      if (value == 1 || value == 2) {
-        MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find bad value after repetitif character\n"));
-        return false;
-      }
-      findRepetitif = false;
-      if (value == 0) {
-        content.append(0x90);
-        continue;
-      }
-      if (content.size()==0) {
-        MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find repetitif character in the first position\n"));
-        return false;
-      }
-      unsigned char lChar = content.getDataBuffer()[content.size()-1];
-      for (int i = 0; i < value-1; i++)
-        content.append(lChar);
-      continue;
-    }
-    if (endData) break;
-  }
-  if (findRepetitif) {
-    MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: find repetitif character in the last position\n"));
-    return false;
-  }
-  auto contentSize=long(content.size());
-  if (contentSize < 27) {
+  // the content is only decoded when it is read
+  std::shared_ptr<MWAWBinHexStream> content(new MWAWBinHexStream(m_stream, m_streamOffset+tell()));
+  unsigned long numBytesRead = 0;
+  unsigned char const *data = content->read(1, numBytesRead);
+  if (!data || numBytesRead != 1) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the content file is too small\n"));
     return false;
   }
-  auto *contentInput=const_cast<librevenge::RVNGInputStream *>(content.getDataStream());
-  auto fileLength = static_cast<int>(readU8(contentInput));
-  if (fileLength < 1 || fileLength > 64 || long(fileLength+21) > contentSize) {
+  auto fileLength = static_cast<int>(data[0]);
+  if (fileLength < 1 || fileLength > 64) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the file name size seems odd\n"));
     return false;
   }
-  contentInput->seek(fileLength+1, librevenge::RVNG_SEEK_CUR); // filename + version
+  // filename, version, type, creator, flags, data and rsrc length, CRC
+  data = content->read(static_cast<unsigned long>(fileLength+21), numBytesRead);
+  if (!data || numBytesRead != static_cast<unsigned long>(fileLength+21)) {
+    MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the content file is too small\n"));
+    return false;
+  }
+  data += fileLength+1; // filename + version
   // creator, type
   std::string type(""), creator("");
   for (int p = 0; p < 4; p++) {
-    auto c = char(readU8(contentInput));
+    auto c = char(data[p]);
     if (c)
       type += c;
   }
-  for (int p = 0; p < 4; p++) {
-    auto c = char(readU8(contentInput));
+  for (int p = 4; p < 8; p++) {
+    auto c = char(data[p]);
     if (c)
       creator += c;
   }
@@ -520,44 +677,43 @@ bool MWAWInputStream::unBinHex()
   else if (creator.length() || type.length()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the file name size seems odd\n"));
   }
-  contentInput->seek(2, librevenge::RVNG_SEEK_CUR); // skip flags
-  auto dataLength = long(readULong(contentInput,4,0,false));
-  auto rsrcLength = long(readULong(contentInput,4,0,false));
-  long pos = contentInput->tell()+2; // skip CRC
-  if (dataLength<0 || rsrcLength < 0 || (dataLength==0 && rsrcLength==0) ||
-      pos+dataLength+rsrcLength+4 > contentSize) {
+  // skip flags
+  auto dataLength = long(decodeULong(data+10, 4, false));
+  auto rsrcLength = long(decodeULong(data+14, 4, false));
+  long pos = content->tell(); // after the CRC
+  if (dataLength<0 || rsrcLength < 0 || (dataLength==0 && rsrcLength==0)) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the data/rsrc fork size seems odd\n"));
     return false;
   }
-  // now read the rsrc and the data fork
+  // the size of the content: header, data fork, CRC, resource fork and CRC
+  long const contentSize=pos+dataLength+rsrcLength+4;
+  /* check that the encoded data can contain the two forks without
+     decoding them: 4 characters encode 3 bytes and a run-length marker
+     followed by its count (2 bytes) encodes at most 254 bytes, so each
+     encoded character gives at most 96 bytes */
+  if (contentSize<pos || contentSize/96 > size()-tell()) {
+    MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: the content seems too short\n"));
+    return false;
+  }
+  content->setDecodedSize(contentSize);
+  // now create the rsrc and the data fork as slices of the content
   if (rsrcLength && getResourceForkStream()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: I already have a resource fork!!!!\n"));
   }
   else if (rsrcLength) {
-    contentInput->seek(pos+dataLength+2, librevenge::RVNG_SEEK_SET);
-    unsigned long numBytesRead = 0;
-    const unsigned char *data =
-      contentInput->read(static_cast<unsigned long>(rsrcLength), numBytesRead);
-    if (numBytesRead != static_cast<unsigned long>(rsrcLength) || !data) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: can not read the resource fork\n"));
-    }
-    else {
-      std::shared_ptr<librevenge::RVNGInputStream> rsrc(new MWAWStringStream(data, static_cast<unsigned int>(numBytesRead)));
-      m_resourceFork.reset(new MWAWInputStream(rsrc,false));
-    }
+    MWAWInputStream contentInput(content, false);
+    m_resourceFork = contentInput.slice(pos+dataLength+2, pos+dataLength+2+rsrcLength);
   }
+  resetWindow();
+  m_streamOffset = 0;
+  m_sliceLength = -1;
+  m_readPos = 0;
   if (!dataLength)
     m_stream.reset();
   else {
-    contentInput->seek(pos, librevenge::RVNG_SEEK_SET);
-    unsigned long numBytesRead = 0;
-    const unsigned char *data =
-      contentInput->read(static_cast<unsigned long>(dataLength), numBytesRead);
-    if (numBytesRead != static_cast<unsigned long>(dataLength) || !data) {
-      MWAW_DEBUG_MSG(("MWAWInputStream::unBinHex: can not read the data fork\n"));
-      return false;
-    }
-    m_stream.reset(new MWAWStringStream(data, static_cast<unsigned int>(numBytesRead)));
+    m_stream = content;
+    m_streamOffset = pos;
+    m_sliceLength = dataLength;
   }
 
   return true;
@@ -579,6 +735,7 @@ bool MWAWInputStream::unsplitInternalMergeStream()
       std::shared_ptr<librevenge::RVNGInputStream> newRsrcFork(m_stream->getSubStreamByName("RsrcInfo"));
       if (newRsrcFork) { // rsrcinfo must be a MacMIME file, it can not be empty
         m_stream.reset(m_stream->getSubStreamByName("DataFork")); // empty data fork is rare, but possible
+        resetWindow();
         m_resourceFork.reset(new MWAWInputStream(newRsrcFork, m_inverseRead)); // rsrcinfo will be decoded by unMacMIME
       }
       else {
@@ -590,6 +747,7 @@ bool MWAWInputStream::unsplitInternalMergeStream()
       if (newRsrcFork) {
         std::shared_ptr<librevenge::RVNGInputStream> newInfo(m_stream->getSubStreamByName("InfoFork"));
         m_stream.reset(m_stream->getSubStreamByName("DataFork"));
+        resetWindow();
         m_resourceFork.reset(new MWAWInputStream(newRsrcFork, m_inverseRead));
         // we must decode the information here
         unsigned long numBytesRead = 0;
@@ -642,6 +800,7 @@ bool MWAWInputStream::unzipStream()
 {
   if (!isStructured()) return false;
   seek(0, librevenge::RVNG_SEEK_SET);
+  m_stream->seek(0, librevenge::RVNG_SEEK_SET);
   unsigned numStream=m_stream->subStreamCount();
   std::vector<std::string> names;
   for (unsigned n=0; n < numStream; ++n) {
@@ -654,6 +813,7 @@ bool MWAWInputStream::unzipStream()
   if (names.size() == 1) {
     // ok as the OLE file must have at least MN and MN0 OLE
     m_stream.reset(m_stream->getSubStreamByName(names[0].c_str()));
+    resetWindow();
     return true;
   }
   if (names.size() != 2)
@@ -675,6 +835,7 @@ bool MWAWInputStream::unzipStream()
   std::shared_ptr<librevenge::RVNGInputStream> rsrcPtr(m_stream->getSubStreamByName(names[1].c_str()));
   m_resourceFork.reset(new MWAWInputStream(rsrcPtr,false));
   m_stream.reset(m_stream->getSubStreamByName(names[0].c_str()));
+  resetWindow();
   return true;
 }
 
@@ -686,32 +847,42 @@ bool MWAWInputStream::unzipStream()
 bool MWAWInputStream::unMacMIME()
 {
   if (m_resourceFork) {
-    std::shared_ptr<librevenge::RVNGInputStream> newDataInput, newRsrcInput;
+    std::shared_ptr<MWAWInputStream> newDataInput, newRsrcInput;
     bool ok = unMacMIME(m_resourceFork.get(), newDataInput, newRsrcInput);
     if (ok && newDataInput) {
       MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: Argh!!! find data stream in the resource block\n"));
       ok = false;
     }
-    if (ok && newRsrcInput)
-      m_resourceFork.reset(new MWAWInputStream(newRsrcInput,false));
-    else if (ok)
-      m_resourceFork.reset();
+    if (ok)
+      m_resourceFork = newRsrcInput;
   }
 
   if (m_stream) {
-    std::shared_ptr<librevenge::RVNGInputStream> newDataInput, newRsrcInput;
+    std::shared_ptr<MWAWInputStream> newDataInput, newRsrcInput;
     bool ok = unMacMIME(this, newDataInput, newRsrcInput);
     if (ok && !newDataInput) {
       MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: Argh!!! data block contains only resources\n"));
     }
     if (ok) {
-      m_stream = newDataInput;
+      // use directly the data fork slice
+      resetWindow();
+      m_readPos = 0;
+      if (newDataInput) {
+        m_stream = newDataInput->m_stream;
+        m_streamOffset = newDataInput->m_streamOffset;
+        m_sliceLength = newDataInput->m_sliceLength;
+      }
+      else {
+        m_stream.reset();
+        m_streamOffset = 0;
+        m_sliceLength = -1;
+      }
       if (newRsrcInput) {
         if (m_resourceFork) {
           MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: Oops!!! find a second resource block, ignored\n"));
         }
         else
-          m_resourceFork.reset(new MWAWInputStream(newRsrcInput,false));
+          m_resourceFork = newRsrcInput;
       }
     }
   }
@@ -721,8 +892,8 @@ bool MWAWInputStream::unMacMIME()
 /* freely inspired from http://tools.ietf.org/html/rfc1740#appendix-A
  */
 bool MWAWInputStream::unMacMIME(MWAWInputStream *inp,
-                                std::shared_ptr<librevenge::RVNGInputStream> &dataInput,
-                                std::shared_ptr<librevenge::RVNGInputStream> &rsrcInput) const
+                                std::shared_ptr<MWAWInputStream> &dataInput,
+                                std::shared_ptr<MWAWInputStream> &rsrcInput) const
 {
   dataInput.reset();
   rsrcInput.reset();
@@ -773,6 +944,15 @@ bool MWAWInputStream::unMacMIME(MWAWInputStream *inp,
         MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: find bad entry pos\n"));
         return false;
       }
+      if (wh==1 || wh==2) { // no need to read the data, a slice is enough
+        if (entrySize > static_cast<unsigned long>(inp->size()) || entryPos > inp->size()-long(entrySize)) {
+          MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read %lX byte\n", static_cast<long unsigned int>(entryPos)));
+          return false;
+        }
+        (wh==1 ? dataInput : rsrcInput) = inp->slice(entryPos, entryPos+long(entrySize));
+        inp->seek(pos+12, librevenge::RVNG_SEEK_SET);
+        continue;
+      }
       /* try to read the data */
       inp->seek(entryPos, librevenge::RVNG_SEEK_SET);
       if (inp->tell() != entryPos) {
@@ -785,38 +965,33 @@ bool MWAWInputStream::unMacMIME(MWAWInputStream *inp,
         MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read %lX byte\n", static_cast<long unsigned int>(entryPos)));
         return false;
       }
-      if (wh==1)
-        dataInput.reset(new MWAWStringStream(data, static_cast<unsigned int>(numBytesRead)));
-      else if (wh==2)
-        rsrcInput.reset(new MWAWStringStream(data, static_cast<unsigned int>(numBytesRead)));
-      else { // the finder info
-        if (entrySize < 8) {
-          MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: finder info size is odd\n"));
-        }
-        else {
-          bool ok = true;
-          std::string type(""), creator("");
-          for (int p = 0; p < 4; p++) {
-            if (!data[p]) {
-              ok = false;
-              break;
-            }
-            type += char(data[p]);
-          }
-          for (int p = 4; ok && p < 8; p++) {
-            if (!data[p]) {
-              ok = false;
-              break;
-            }
-            creator += char(data[p]);
-          }
-          if (ok) {
-            m_fInfoType = type;
-            m_fInfoCreator = creator;
+      // the finder info
+      if (entrySize < 8) {
+        MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: finder info size is odd\n"));
+      }
+      else {
+        bool ok = true;
+        std::string type(""), creator("");
+        for (int p = 0; p < 4; p++) {
+          if (!data[p]) {
+            ok = false;
+            break;
           }
-          else if (type.length()) {
-            MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read find info\n"));
+          type += char(data[p]);
+        }
+        for (int p = 4; ok && p < 8; p++) {
+          if (!data[p]) {
+            ok = false;
+            break;
           }
+          creator += char(data[p]);
+        }
+        if (ok) {
+          m_fInfoType = type;
+          m_fInfoCreator = creator;
+        }
+        else if (type.length()) {
+          MWAW_DEBUG_MSG(("MWAWInputStream::unMacMIME: can not read find info\n"));
         }
       }
 
@@ -837,7 +1012,8 @@ bool MWAWInputStream::unMacMIME(MWAWInputStream *inp,
 
 bool MWAWInputStream::isStructured()
 {
-  if (!m_stream) return false;
+  // a memory mapped file is never structured
+  if (!m_stream || m_sliceLength>=0 || m_windowIsMapped) return false;
   long pos=m_stream->tell();
   bool ok=m_stream->isStructured();
   m_stream->seek(pos, librevenge::RVNG_SEEK_SET);
@@ -846,7 +1022,7 @@ bool MWAWInputStream::isStructured()
 
 unsigned MWAWInputStream::subStreamCount()
 {
-  if (!m_stream || !m_stream->isStructured()) {
+  if (!m_stream || m_sliceLength>=0 || !m_stream->isStructured()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::subStreamCount: called on unstructured file\n"));
     return 0;
   }
@@ -855,7 +1031,7 @@ unsigned MWAWInputStream::subStreamCount()
 
 std::string MWAWInputStream::subStreamName(unsigned id)
 {
-  if (!m_stream || !m_stream->isStructured()) {
+  if (!m_stream || m_sliceLength>=0 || !m_stream->isStructured()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::subStreamName: called on unstructured file\n"));
     return std::string("");
   }
@@ -870,15 +1046,13 @@ std::string MWAWInputStream::subStreamName(unsigned id)
 std::shared_ptr<MWAWInputStream> MWAWInputStream::getSubStreamByName(std::string const &name)
 {
   std::shared_ptr<MWAWInputStream> empty;
-  if (!m_stream || !m_stream->isStructured() || name.empty()) {
+  if (!m_stream || m_sliceLength>=0 || !m_stream->isStructured() || name.empty()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::getSubStreamByName: called on unstructured file\n"));
     return empty;
   }
 
-  long actPos = tell();
-  seek(0, librevenge::RVNG_SEEK_SET);
+  m_stream->seek(0, librevenge::RVNG_SEEK_SET);
   std::shared_ptr<librevenge::RVNGInputStream> res(m_stream->getSubStreamByName(name.c_str()));
-  seek(actPos, librevenge::RVNG_SEEK_SET);
 
   if (!res)
     return empty;
@@ -890,15 +1064,13 @@ std::shared_ptr<MWAWInputStream> MWAWInputStream::getSubStreamByName(std::string
 std::shared_ptr<MWAWInputStream> MWAWInputStream::getSubStreamById(unsigned id)
 {
   std::shared_ptr<MWAWInputStream> empty;
-  if (!m_stream || !m_stream->isStructured()) {
+  if (!m_stream || m_sliceLength>=0 || !m_stream->isStructured()) {
     MWAW_DEBUG_MSG(("MWAWInputStream::getSubStreamById: called on unstructured file\n"));
     return empty;
   }
 
-  long actPos = tell();
-  seek(0, librevenge::RVNG_SEEK_SET);
+  m_stream->seek(0, librevenge::RVNG_SEEK_SET);
   std::shared_ptr<librevenge::RVNGInputStream> res(m_stream->getSubStreamById(id));
-  seek(actPos, librevenge::RVNG_SEEK_SET);
 
   if (!res)
     return empty;
@@ -926,7 +1098,7 @@ bool MWAWInputStream::readDataBlock(long sz, librevenge::RVNGBinaryData &data)
 
   const unsigned char *readData;
   unsigned long sizeRead;
-  if ((readData=m_stream->read(static_cast<unsigned long>(sz), sizeRead)) == nullptr || long(sizeRead)!=sz)
+  if ((readData=read(static_cast<size_t>(sz), sizeRead)) == nullptr || long(sizeRead)!=sz)
     return false;
   data.append(readData, sizeRead);
   return true;
@@ -49,6 +49,12 @@
  *  - selection of a section of a stream
  *  - read block of data
  *  - interface with modified librevenge::RVNGOLEStream
+ *
+ * \note the numbers are decoded from a read window which is filled by
+ * block from the basic librevenge::RVNGInputStream, so this class
+ * maintains its own position and the position of the basic stream
+ * must not be used. When the basic stream is a MWAWMappedStream, the
+ * read window is directly the mapped file.
  */
 class MWAWInputStream
 {
@@ -67,13 +73,44 @@ public:
   //! destructor
   ~MWAWInputStream();
 
-  //! returns the basic librevenge::RVNGInputStream
+  /** returns the basic librevenge::RVNGInputStream
+
+      \note if this input is a slice, the position 0 of this input corresponds
+      to the position sliceBegin() of the basic stream */
   std::shared_ptr<librevenge::RVNGInputStream> input()
   {
     return m_stream;
   }
   //! returns a new input stream corresponding to a librevenge::RVNGBinaryData
   static std::shared_ptr<MWAWInputStream> get(librevenge::RVNGBinaryData const &data, bool inverted);
+  /** returns a new input stream corresponding to the data of this input between begin and end.
+
+      \note the data are not copied, the new input shares the basic
+      librevenge::RVNGInputStream of this input, so this input can be
+      destroyed while the slice is used. The slice has no resource fork
+      and is not structured. */
+  std::shared_ptr<MWAWInputStream> slice(long begin, long end);
+  //! returns the position of the beginning of the slice in the basic stream (0 if the input is not a slice)
+  long sliceBegin() const
+  {
+    return m_streamOffset;
+  }
+  /** returns true if the data fork is read directly in a memory mapped
+      file, ie. if the data never change and can be read by several
+      threads using copyCursor */
+  bool isMemoryMapped() const
+  {
+    return m_windowIsMapped;
+  }
+  /** returns a new input which shares the data, the finder info and the
+      resource fork of this input, but which has its own reading position.
+      Returns an empty pointer if the data fork or the resource fork are
+      not memory mapped.
+
+      \note the inputs created by this function can be read
+      simultaneously in different threads, but they must be created in
+      the thread which owns this input */
+  std::shared_ptr<MWAWInputStream> copyCursor() const;
 
   //! returns the endian mode (see constructor)
   bool readInverted() const
@@ -143,7 +180,12 @@ public:
   //! returns a uint8, uint16, uint32 readed from actualPos
   unsigned long readULong(int num)
   {
-    return readULong(m_stream.get(), num, 0, m_inverseRead);
+    if (num>0 && num<=4 && m_readPos>=m_windowBegin && m_readPos+num<=m_windowEnd) {
+      unsigned char const *p=m_windowData+(m_readPos-m_windowBegin);
+      m_readPos+=num;
+      return decodeULong(p, num, m_inverseRead);
+    }
+    return readULongInWindow(num);
   }
   //! return a int8, int16, int32 readed from actualPos
   long readLong(int num);
@@ -154,6 +196,25 @@ public:
   //! try to read a double of size 10: 2 bytes exponent, 8 bytes mantisse
   bool readDouble10(double &res, bool &isNotANumber);
 
+  /** try to read n uint16 from actualPos, using the current endian order
+
+      \note if the zone (or the current read limit) does not contain
+      2*n bytes, returns false and does not move */
+  bool readU16Array(uint16_t *res, size_t n);
+  //! try to read n int16 from actualPos, see readU16Array
+  bool readS16Array(int16_t *res, size_t n);
+  //! try to read n uint32 from actualPos, see readU16Array
+  bool readU32Array(uint32_t *res, size_t n);
+  //! try to read n int32 from actualPos, see readU16Array
+  bool readS32Array(int32_t *res, size_t n);
+  /** try to read n double of size 8 from actualPos, see readDouble8
+
+      \note if the zone does not contain 8*n bytes, returns false and
+      does not move. The not a number values are stored as quiet NaN, the invalid
+      values are stored as 0 and the function returns false after
+      having read the array */
+  bool readDouble8Array(double *res, size_t n);
+
   /**! reads numbytes data, WITHOUT using any endian or section consideration
    * \return a pointer to the read elements
    */
@@ -162,6 +223,20 @@ public:
    *  - where a is the previous read data
    */
   static unsigned long readULong(librevenge::RVNGInputStream *stream, int num, unsigned long a, bool inverseRead);
+  //! internal function used to decode a uint8, uint16, uint32 stored in p
+  static unsigned long decodeULong(unsigned char const *p, int num, bool inverseRead)
+  {
+    unsigned long res=0;
+    if (inverseRead) {
+      for (int i=num-1; i>=0; --i)
+        res=(res<<8)|static_cast<unsigned long>(p[i]);
+    }
+    else {
+      for (int i=0; i<num; ++i)
+        res=(res<<8)|static_cast<unsigned long>(p[i]);
+    }
+    return res;
+  }
 
   //! reads a librevenge::RVNGBinaryData with a given size in the actual section/file
   bool readDataBlock(long size, librevenge::RVNGBinaryData &data);
@@ -225,6 +300,21 @@ protected:
   void updateStreamSize();
   //! internal function used to read a byte
   static uint8_t readU8(librevenge::RVNGInputStream *stream);
+  //! internal function used by readULong when the data are not in the read window
+  unsigned long readULongInWindow(int num);
+  //! internal function used to read an array of n integers of size sizeof(T)
+  template <typename T> bool readArray(T *res, size_t n);
+  /*! \brief internal function used to refill the read window so that it begins at pos
+   * \return the number of bytes which can be read from pos
+   */
+  long fillWindow(long pos, long numBytes);
+  //! internal function used to invalidate the read window (must be called if m_stream is modified)
+  void resetWindow()
+  {
+    m_windowData=nullptr;
+    m_windowBegin=m_windowEnd=0;
+    m_windowIsMapped=false;
+  }
 
   //! unbinhex the data in the file is a BinHex 4.0 file of a mac file
   bool unBinHex();
@@ -232,10 +322,10 @@ protected:
   bool unzipStream();
   //! check if some stream are in MacMIME format, if so de MacMIME
   bool unMacMIME();
-  //! de MacMIME an input stream
+  //! de MacMIME an input stream: the data and resource forks are returned as slices of input
   bool unMacMIME(MWAWInputStream *input,
-                 std::shared_ptr<librevenge::RVNGInputStream> &dataInput,
-                 std::shared_ptr<librevenge::RVNGInputStream> &rsrcInput) const;
+                 std::shared_ptr<MWAWInputStream> &dataInput,
+                 std::shared_ptr<MWAWInputStream> &rsrcInput) const;
   //! check if a stream is an internal merge stream
   bool unsplitInternalMergeStream();
 
@@ -248,6 +338,23 @@ protected:
   std::shared_ptr<librevenge::RVNGInputStream> m_stream;
   //! the stream size
   long m_streamSize;
+  //! the position in m_stream which corresponds to the position 0 of this input (used by slice)
+  long m_streamOffset;
+  //! the slice length or -1 if this input is not a slice
+  long m_sliceLength;
+  //! the actual position
+  long m_readPos;
+
+  //! the data of m_stream between m_windowBegin and m_windowEnd
+  unsigned char const *m_windowData;
+  //! the buffer used to store a copy of the read window
+  std::vector<unsigned char> m_windowBuffer;
+  //! the position in m_stream of the first byte of the read window
+  long m_windowBegin;
+  //! the position in m_stream which follows the last byte of the read window
+  long m_windowEnd;
+  //! a flag to know if the read window contains the whole data of a MWAWMappedStream
+  bool m_windowIsMapped;
 
   //! actual section limit (-1 if no limit)
   long m_readLimit;
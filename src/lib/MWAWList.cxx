@@ -40,6 +40,7 @@
 
 #include "MWAWFont.hxx"
 #include "MWAWList.hxx"
+#include "MWAWParagraph.hxx"
 
 ////////////////////////////////////////////////////////////
 // list level functions
@@ -432,4 +433,20 @@ std::shared_ptr<MWAWList> MWAWListManager::getNewList(std::shared_ptr<MWAWList>
   return std::shared_ptr<MWAWList>(new MWAWList(res));
 }
 
+int MWAWListManager::getListId(MWAWParagraph const &para, std::shared_ptr<MWAWList> actList)
+{
+  auto newLevel= size_t(para.m_listLevelIndex.get());
+  if (newLevel == 0) return -1;
+  int newListId = para.m_listId.get();
+  if (newListId > 0) return newListId;
+  static bool first = true;
+  if (first) {
+    MWAW_DEBUG_MSG(("MWAWListManager::getListId: the list id is not set, try to find a new one\n"));
+    first = false;
+  }
+  auto list=getNewList(actList, int(newLevel), *para.m_listLevel);
+  if (!list) return -1;
+  return list->getId();
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
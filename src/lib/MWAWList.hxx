@@ -225,6 +225,56 @@ public:
   std::shared_ptr<MWAWList> getList(int index) const;
   //! returns a new list corresponding to a list where we have a new level
   std::shared_ptr<MWAWList> getNewList(std::shared_ptr<MWAWList> actList, int levl, MWAWListLevel const &level);
+  /** returns the list id of a paragraph: its list id if it is set or the id of
+      a list compatible with actList and the paragraph's list level (or -1) */
+  int getListId(MWAWParagraph const &para, std::shared_ptr<MWAWList> actList);
+  /** closes and opens the list levels in the interface so that the
+      opened levels correspond to the level newLevel of the list newListId.
+
+      orderedLevels is the stack of opened levels (true for an ordered
+      level), list the actual list and idMarkerList the list of lists
+      already sent, see needToSend.
+      \return false if the list newListId is not found
+   */
+  template <class Interface>
+  bool changeLevels(Interface &interface, int newListId, size_t newLevel, std::vector<bool> &orderedLevels,
+                    std::shared_ptr<MWAWList> &list, std::vector<int> &idMarkerList) const
+  {
+    size_t actualLevel = orderedLevels.size();
+    bool changeList = newLevel && (list && list->getId()!=newListId);
+    size_t minLevel = changeList ? 0 : newLevel;
+    while (actualLevel > minLevel) {
+      if (orderedLevels[--actualLevel])
+        interface.closeOrderedListLevel();
+      else
+        interface.closeUnorderedListLevel();
+    }
+
+    if (newLevel) {
+      std::shared_ptr<MWAWList> theList=getList(newListId);
+      if (!theList) {
+        orderedLevels.resize(actualLevel);
+        return false;
+      }
+      needToSend(newListId, idMarkerList);
+      list = theList;
+      list->setLevel(static_cast<int>(newLevel));
+    }
+
+    orderedLevels.resize(newLevel, false);
+    for (size_t i=actualLevel+1; i<= newLevel; i++) {
+      bool ordered = list->isNumeric(int(i));
+      orderedLevels[i-1] = ordered;
+
+      librevenge::RVNGPropertyList level;
+      list->addTo(int(i), level, m_fontManager);
+      if (ordered)
+        interface.openOrderedListLevel(level);
+      else
+        interface.openUnorderedListLevel(level);
+    }
+    return true;
+  }
 protected:
   //! the font manager
   MWAWFontManagerPtr m_fontManager;
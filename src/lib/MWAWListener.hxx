@@ -103,6 +103,10 @@ public:
       \return the number of extra character read
    */
   virtual int insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos=-1)=0;
+  /** insert a run of characters using the font converter to find the utf8
+      characters, this is similar to calling insertCharacter(c, input, endPos)
+      on each character but faster */
+  virtual void insertCharacters(uint8_t const *data, size_t len)=0;
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   virtual void insertUnicode(uint32_t character)=0;
@@ -0,0 +1,137 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <cstring>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#  define MWAW_USE_MMAP 1
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "libmwaw_internal.hxx"
+
+#include "MWAWMappedStream.hxx"
+
+MWAWMappedStream::MWAWMappedStream(char const *fileName)
+  : librevenge::RVNGInputStream()
+  , m_data(nullptr)
+  , m_dataSize(0)
+  , m_offset(0)
+{
+#ifdef MWAW_USE_MMAP
+  if (!fileName)
+    return;
+  int fd=open(fileName, O_RDONLY);
+  if (fd<0)
+    return;
+  struct stat status;
+  if (fstat(fd, &status)==0 && S_ISREG(status.st_mode) && status.st_size>0) {
+    void *res=mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (res!=MAP_FAILED) {
+      m_data=static_cast<unsigned char const *>(res);
+      m_dataSize=static_cast<unsigned long>(status.st_size);
+#  ifdef POSIX_MADV_WILLNEED
+      posix_madvise(res, size_t(m_dataSize), POSIX_MADV_WILLNEED);
+#  endif
+    }
+    else {
+      MWAW_DEBUG_MSG(("MWAWMappedStream::MWAWMappedStream: can not map the file %s\n", fileName));
+    }
+  }
+  // the mapping stays valid after the file is closed
+  close(fd);
+#else
+  (void) fileName;
+#endif
+}
+
+MWAWMappedStream::~MWAWMappedStream()
+{
+#ifdef MWAW_USE_MMAP
+  if (m_data)
+    munmap(const_cast<unsigned char *>(m_data), size_t(m_dataSize));
+#endif
+}
+
+bool MWAWMappedStream::isStructuredFile() const
+{
+  if (!m_data || m_dataSize<4)
+    return false;
+  // OLE file
+  static unsigned char const oleSignature[]= {0xd0, 0xcf, 0x11, 0xe0, 0xa1, 0xb1, 0x1a, 0xe1};
+  if (m_dataSize>=8 && std::memcmp(m_data, oleSignature, 8)==0)
+    return true;
+  // Zip file: look for a local header or for the end of central directory
+  if (m_data[0]=='P' && m_data[1]=='K' && m_data[2]==3 && m_data[3]==4)
+    return true;
+  if (m_dataSize<22)
+    return false;
+  unsigned long minPos=m_dataSize>22+0xFFFF ? m_dataSize-22-0xFFFF : 0;
+  for (unsigned long pos=m_dataSize-22;; --pos) {
+    if (m_data[pos]=='P' && m_data[pos+1]=='K' && m_data[pos+2]==5 && m_data[pos+3]==6)
+      return true;
+    if (pos==minPos)
+      break;
+  }
+  return false;
+}
+
+const unsigned char *MWAWMappedStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+  numBytesRead = 0;
+  if (numBytes == 0 || !m_data || m_offset>=long(m_dataSize))
+    return nullptr;
+
+  unsigned long remain=m_dataSize-static_cast<unsigned long>(m_offset);
+  numBytesRead = numBytes<remain ? numBytes : remain;
+
+  long oldOffset = m_offset;
+  m_offset += long(numBytesRead);
+  return m_data+oldOffset;
+}
+
+int MWAWMappedStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
+{
+  if (seekType == librevenge::RVNG_SEEK_CUR)
+    m_offset += offset;
+  else if (seekType == librevenge::RVNG_SEEK_SET)
+    m_offset = offset;
+  else if (seekType == librevenge::RVNG_SEEK_END)
+    m_offset = offset+long(m_dataSize);
+
+  if (m_offset < 0) {
+    m_offset = 0;
+    return -1;
+  }
+  if (m_offset > long(m_dataSize)) {
+    m_offset = long(m_dataSize);
+    return -1;
+  }
+
+  return 0;
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,138 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#ifndef MWAW_MAPPED_STREAM_HXX
+#define MWAW_MAPPED_STREAM_HXX
+
+#include <librevenge-stream/librevenge-stream.h>
+
+/** internal class used to create a RVNGInputStream from a file mapped in memory
+
+    The read function returns a pointer in the mapped file, ie. no data
+    is copied, and the pointer stays valid while the stream exists.
+
+    \note this class does not implement the isStructured's protocol,
+    ie. it only returns false, so it must not be used to read OLE or
+    Zip files (see isStructuredFile).
+ */
+class MWAWMappedStream final : public librevenge::RVNGInputStream
+{
+public:
+  //! constructor: tries to map the file in memory
+  explicit MWAWMappedStream(char const *fileName);
+  //! destructor
+  ~MWAWMappedStream() final;
+
+  //! returns true if the file has been mapped in memory
+  bool isValid() const
+  {
+    return m_data!=nullptr;
+  }
+  //! returns a pointer to the beginning of the mapped data
+  const unsigned char *data() const
+  {
+    return m_data;
+  }
+  //! returns the size of the mapped data
+  unsigned long dataSize() const
+  {
+    return m_dataSize;
+  }
+  //! returns true if the data look like a OLE or a Zip file
+  bool isStructuredFile() const;
+
+  /**! reads numbytes data.
+
+   * \return a pointer to the read elements
+   */
+  const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead) final;
+  //! returns actual offset position
+  long tell() final
+  {
+    return m_offset;
+  }
+  /*! \brief seeks to a offset position, from actual, beginning or ending position
+   * \return 0 if ok
+   */
+  int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType) final;
+  //! returns true if we are at the end of the section/file
+  bool isEnd() final
+  {
+    return m_offset>=long(m_dataSize);
+  }
+
+  /** returns true if the stream is ole
+
+   \sa returns always false*/
+  bool isStructured() final
+  {
+    return false;
+  }
+  /** returns the number of sub streams.
+
+   \sa returns always 0*/
+  unsigned subStreamCount() final
+  {
+    return 0;
+  }
+  /** returns the ith sub streams name
+
+   \sa returns always 0*/
+  const char *subStreamName(unsigned) final
+  {
+    return nullptr;
+  }
+  /** returns true if a substream with name exists
+
+   \sa returns always false*/
+  bool existsSubStream(const char *) final
+  {
+    return false;
+  }
+  /** return a new stream for a ole zone
+
+   \sa returns always 0 */
+  librevenge::RVNGInputStream *getSubStreamByName(const char *) final
+  {
+    return nullptr;
+  }
+  /** return a new stream for a ole zone
+
+   \sa returns always 0 */
+  librevenge::RVNGInputStream *getSubStreamById(unsigned) final
+  {
+    return nullptr;
+  }
+
+private:
+  //! the mapped data
+  unsigned char const *m_data;
+  //! the mapped data size
+  unsigned long m_dataSize;
+  //! the stream offset
+  long m_offset;
+  MWAWMappedStream(const MWAWMappedStream &) = delete; // copy is not allowed
+  MWAWMappedStream &operator=(const MWAWMappedStream &) = delete; // assignment is not allowed
+};
+
+#endif
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,69 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <cstring>
+
+#include "MWAWPackBits.hxx"
+
+namespace libmwaw
+{
+bool PackBits::unpack(unsigned char const *&data, unsigned char const *dataEnd,
+                      unsigned char *output, size_t outputSize, size_t &numWritten,
+                      int unitSize, int flags)
+{
+  numWritten=0;
+  if (!data || dataEnd<data || (!output && outputSize) || unitSize<1 || unitSize>4)
+    return false;
+  auto const unit=size_t(unitSize);
+  bool lastLiteral=false;
+  while (data<dataEnd && numWritten<outputSize) {
+    unsigned const header=*data;
+    auto const numData=size_t(dataEnd-data)-1;
+    size_t const numFree=outputSize-numWritten;
+    if (header>0x80 || (header==0x80 && (flags&F_Literal0x80)==0)) {
+      size_t const num=size_t(0x101-header);
+      if (numData<unit || numFree/unit<num)
+        return false;
+      if (unit==1)
+        std::memset(output+numWritten, data[1], num);
+      else {
+        for (size_t i=0; i<num; ++i)
+          std::memcpy(output+numWritten+i*unit, data+1, unit);
+      }
+      data+=1+unit;
+      numWritten+=num*unit;
+      lastLiteral=false;
+      continue;
+    }
+    if (lastLiteral && (flags&F_NoConsecutiveLiterals))
+      return false;
+    size_t const num=size_t(header+1)*unit;
+    if (numData<num || numFree<num)
+      return false;
+    std::memcpy(output+numWritten, data+1, num);
+    data+=1+num;
+    numWritten+=num;
+    lastLiteral=true;
+  }
+  return true;
+}
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,61 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#ifndef MWAW_PACK_BITS_HXX
+#define MWAW_PACK_BITS_HXX
+
+#include <cstddef>
+
+namespace libmwaw
+{
+/** small class used to decode the data compressed with the Macintosh
+    PackBits algorithm, ie. a list of blocks which begin by a header
+    byte n:
+    - if n<0x80, the following n+1 units are copied,
+    - if n>0x80, the following unit is repeated 0x101-n times,
+    - the header 0x80 is normally unused, by default it is read as a
+    run of 129 units (see F_Literal0x80),
+
+    where a unit is a group of 1 to 4 bytes (for instance a 16 bits pixel).
+ */
+class PackBits
+{
+public:
+  //! the flags which change the decoding
+  enum Flag {
+    F_Literal0x80=1 /** read the header 0x80 as 129 literal units */,
+    F_NoConsecutiveLiterals=2 /** reject the data which contain two consecutive literal blocks */
+  };
+  /** decodes the blocks of [data,dataEnd) in output, stops when all
+      the data are read or when outputSize bytes are written.
+
+      \return false if a block is truncated, overflows the output or
+      is rejected by the flags. On return, data points after the last
+      decoded block and numWritten contains the number of written
+      bytes.
+   */
+  static bool unpack(unsigned char const *&data, unsigned char const *dataEnd,
+                     unsigned char *output, size_t outputSize, size_t &numWritten,
+                     int unitSize=1, int flags=0);
+};
+}
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
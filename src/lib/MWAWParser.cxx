@@ -57,6 +57,11 @@ MWAWParserState::MWAWParserState(MWAWParserState::Type type, MWAWInputStreamPtr
   , m_spreadsheetListener()
   , m_textListener()
   , m_version(0)
+  , m_textOnly(false)
+  , m_maxPages(0)
+  , m_maxPagesReached(false)
+  , m_rawBitmaps(false)
+  , m_parseOptions()
   , m_asciiFile(input)
 {
   if (header) {
@@ -117,6 +122,11 @@ MWAWParser::~MWAWParser()
 {
 }
 
+bool MWAWParser::readMetaData(librevenge::RVNGPropertyList &/*metaData*/)
+{
+  return false;
+}
+
 MWAWListenerPtr MWAWParser::getMainListener()
 {
   return m_parserState->getMainListener();
@@ -57,6 +57,12 @@ public:
   ~MWAWParserState();
   //! returns the main listener
   MWAWListenerPtr getMainListener();
+  //! returns true if the page/slide (numbered from 0) must be sent, see MWAWDocument::ParseOptions
+  bool isPageSent(int page) const
+  {
+    return m_maxPages<=0 || page<m_maxPages;
+  }
+
   //! the state type
   Type m_type;
   //! the document kind
@@ -86,6 +92,16 @@ public:
   MWAWTextListenerPtr m_textListener;
   //! the actual version
   int m_version;
+  //! a flag to know if we only need to retrieve the text, see MWAWDocument::ParseOptions
+  bool m_textOnly;
+  //! the maximum number of pages to send (0 means all), see MWAWDocument::ParseOptions
+  int m_maxPages;
+  //! a flag to know if the parsing was stopped after the last requested page
+  bool m_maxPagesReached;
+  //! a flag to know if the bitmaps are sent without being encoded, see MWAWDocument::ParseOptions
+  bool m_rawBitmaps;
+  //! the parse options, used to encode the bitmaps in PNG files, see MWAWDocument::ParseOptions
+  MWAWDocument::ParseOptions m_parseOptions;
 
   //! the debug file
   libmwaw::DebugFile m_asciiFile;
@@ -103,6 +119,10 @@ public:
   virtual ~MWAWParser();
   //! virtual function used to check if the document header is correct (or not)
   virtual bool checkHeader(MWAWHeader *header, bool strict=false) = 0;
+  /** virtual function used to retrieve the document meta data: only
+      the header and the summary zones are read, the document content is
+      neither parsed nor sent. Returns false if no meta data are found */
+  virtual bool readMetaData(librevenge::RVNGPropertyList &metaData);
 
   //! returns the works version
   int version() const
@@ -34,8 +34,15 @@
 /* This header contains code specific to some bitmap
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 #ifdef USE_ZLIB
 #  include <zlib.h>
 #endif
@@ -49,11 +56,6 @@
 //! Internal: namespace used to define some internal function
 namespace MWAWPictBitmapInternal
 {
-#ifdef USE_ZLIB
-//
-// functions used by getPNGData
-//
-
 //! Internal: small function to store an unsigned value in big endian
 static void writeBEU32(unsigned char *buffer, const unsigned value)
 {
@@ -63,6 +65,75 @@ static void writeBEU32(unsigned char *buffer, const unsigned value)
   *(buffer++) = static_cast<unsigned char>(value & 0xFF);
 }
 
+//! Internal: small function to read an unsigned value stored in big endian
+static unsigned readBEU32(unsigned char const *buffer)
+{
+  return (unsigned(buffer[0])<<24) | (unsigned(buffer[1])<<16) | (unsigned(buffer[2])<<8) | unsigned(buffer[3]);
+}
+
+//
+// functions used by createRawData and decodeRawData
+//
+
+//! Internal: the header size of a "image/mwaw-raw" data
+static unsigned const s_rawHeaderSize=20;
+
+//! Internal: returns the number of bytes of a row of a "image/mwaw-raw" data
+static size_t getRawRowSize(unsigned width, unsigned bitsByPixel)
+{
+  return (size_t(width)*bitsByPixel+7)/8;
+}
+
+//! Internal: stores the header and the palette of a "image/mwaw-raw" data
+static bool addRawHeader(MWAWVec2i const &sz, unsigned bitsByPixel, std::vector<MWAWColor> const &colors, librevenge::RVNGBinaryData &data)
+{
+  if (sz[0] <= 0 || sz[1] <= 0) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmapInternal::addRawHeader: the bitmap size seems bad\n"));
+    return false;
+  }
+  std::vector<unsigned char> header(s_rawHeaderSize+4*colors.size(), 0);
+  std::memcpy(header.data(), "MRAW", 4);
+  writeBEU32(&header[4], unsigned(sz[0]));
+  writeBEU32(&header[8], unsigned(sz[1]));
+  header[13]=static_cast<unsigned char>(bitsByPixel);
+  writeBEU32(&header[16], unsigned(colors.size()));
+  size_t pos=s_rawHeaderSize;
+  for (auto const &color : colors) {
+    header[pos++]=color.getRed();
+    header[pos++]=color.getGreen();
+    header[pos++]=color.getBlue();
+    header[pos++]=color.getAlpha();
+  }
+  data.clear();
+  data.append(header.data(), header.size());
+  return true;
+}
+
+//! Internal: helper function to store the pixels of an indexed bitmap in a "image/mwaw-raw" data
+template <class T>
+bool getIndexedRawData(MWAWPictBitmapContainer<T> const &orig, std::vector<MWAWColor> const &colors, librevenge::RVNGBinaryData &data)
+{
+  MWAWVec2i const &sz=orig.size();
+  if (!addRawHeader(sz, 8*unsigned(sizeof(T)), colors, data))
+    return false;
+  std::vector<unsigned char> row(getRawRowSize(unsigned(sz[0]), 8*unsigned(sizeof(T))));
+  for (int j=0; j<sz[1]; ++j) {
+    T const *values=orig.getRow(j);
+    unsigned char *ptr=row.data();
+    for (int i=0; i<sz[0]; ++i) {
+      for (int b=int(sizeof(T))-1; b>=0; --b)
+        *(ptr++)=static_cast<unsigned char>(values[i]>>(8*b));
+    }
+    data.append(row.data(), row.size());
+  }
+  return true;
+}
+
+#ifdef USE_ZLIB
+//
+// functions used by getPNGData
+//
+
 //! Internal: add a chunk zone in a PNG file
 static void addChunkInPNG(unsigned chunkType, unsigned char const *buffer, unsigned length, librevenge::RVNGBinaryData &data)
 {
@@ -81,14 +152,246 @@ static void addChunkInPNG(unsigned chunkType, unsigned char const *buffer, unsig
   data.append(buf4, 4);
 }
 
+/** Internal: returns the Paeth predictor of a pixel knowing its left,
+    upper and upper left neighbours */
+static int paethPredictor(int a, int b, int c)
+{
+  int const p=a+b-c;
+  int const pa=std::abs(p-a), pb=std::abs(p-b), pc=std::abs(p-c);
+  if (pa<=pb && pa<=pc) return a;
+  return pb<=pc ? b : c;
+}
+
+/** Internal: stores in res the filter type and the filtered row,
+    choosing the filter which minimizes the sum of the absolute
+    differences (the heuristic recommended by the PNG specification)
+
+    \note prevRow is null for the first row, tmp must be able to store
+    5*rowSize bytes
+ */
+static void filterPNGRow(unsigned char const *row, unsigned char const *prevRow, unsigned rowSize, unsigned bytesPerPixel,
+                         unsigned char *res, unsigned char *tmp)
+{
+  int bestFilter=0;
+  unsigned long bestSum=0;
+  for (int filter=0; filter<5; ++filter) {
+    unsigned char *dest=tmp+unsigned(filter)*rowSize;
+    unsigned long sum=0;
+    for (unsigned i=0; i<rowSize; ++i) {
+      int const a=i>=bytesPerPixel ? row[i-bytesPerPixel] : 0;
+      int const b=prevRow ? prevRow[i] : 0;
+      int const c=(prevRow && i>=bytesPerPixel) ? prevRow[i-bytesPerPixel] : 0;
+      int pred=0;
+      switch (filter) {
+      case 1: // sub
+        pred=a;
+        break;
+      case 2: // up
+        pred=b;
+        break;
+      case 3: // average
+        pred=(a+b)/2;
+        break;
+      case 4:
+        pred=paethPredictor(a,b,c);
+        break;
+      default: // none
+        break;
+      }
+      auto const val=static_cast<unsigned char>(row[i]-pred);
+      dest[i]=val;
+      sum+=unsigned(val<128 ? val : 256-val);
+    }
+    if (filter==0 || sum<bestSum) {
+      bestFilter=filter;
+      bestSum=sum;
+    }
+  }
+  *(res++)=static_cast<unsigned char>(bestFilter);
+  std::memcpy(res, tmp+unsigned(bestFilter)*rowSize, rowSize);
+}
+
+//! Internal: a band of rows compressed independently by createPNGFile
+struct PNGBand {
+  //! constructor
+  PNGBand(unsigned begin, unsigned end)
+    : m_begin(begin)
+    , m_end(end)
+    , m_data()
+    , m_adler(0)
+    , m_ok(false)
+  {
+  }
+  //! the first position of the band in the image
+  unsigned m_begin;
+  //! the end position of the band in the image
+  unsigned m_end;
+  //! the raw deflate data
+  std::vector<unsigned char> m_data;
+  //! the adler32 checksum of the band data
+  uLong m_adler;
+  //! a flag to know if the compression succeeds
+  bool m_ok;
+};
+
+/** Internal: compresses a band of image in a raw deflate stream.
+
+    The end of the previous band is used as dictionary and the stream
+    is terminated by a sync flush (or by the final block for the last
+    band), so that the band streams can be concatenated.
+ */
+static void deflatePNGBand(unsigned char const *image, PNGBand &band, int level, int strategy, bool isLast)
+try
+{
+  band.m_adler=adler32(adler32(0, nullptr, 0), image+band.m_begin, band.m_end-band.m_begin);
+  z_stream strm;
+  strm.zalloc = nullptr;
+  strm.zfree = nullptr;
+  strm.opaque = nullptr;
+  if (deflateInit2(&strm, level, Z_DEFLATED, -15, 8, strategy)!=Z_OK) return;
+  if (band.m_begin) {
+    unsigned const dictSize=std::min(band.m_begin, 32768u);
+    deflateSetDictionary(&strm, image+band.m_begin-dictSize, dictSize);
+  }
+  strm.next_in = const_cast<unsigned char *>(image+band.m_begin);
+  strm.avail_in = band.m_end-band.m_begin;
+  auto &output=band.m_data;
+  output.resize(size_t(deflateBound(&strm, strm.avail_in))+64);
+  strm.next_out = output.data();
+  strm.avail_out = uInt(output.size());
+  int const flush=isLast ? Z_FINISH : Z_SYNC_FLUSH;
+  int res;
+  while ((res=deflate(&strm, flush))==Z_OK && (isLast || strm.avail_out==0)) {
+    // the buffer is full
+    size_t const used=output.size()-strm.avail_out;
+    output.resize(2*output.size());
+    strm.next_out = output.data()+used;
+    strm.avail_out = uInt(output.size()-used);
+  }
+  output.resize(output.size()-strm.avail_out);
+  deflateEnd(&strm);
+  band.m_ok=isLast ? res==Z_STREAM_END : (res==Z_OK && strm.avail_in==0);
+}
+catch (...)
+{
+  band.m_ok=false;
+}
+
+//! Internal: calls func(0), ..., func(numTasks-1) using at most numThreads threads
+template <class Function>
+void runPNGTasks(size_t numTasks, int numThreads, Function const &func)
+{
+  std::atomic<size_t> nextId(0);
+  auto worker=[&]() {
+    size_t id;
+    while ((id=nextId++)<numTasks)
+      func(id);
+  };
+  std::vector<std::thread> threads;
+  for (size_t i=1; i<numTasks && i<size_t(numThreads); ++i) {
+    try {
+      threads.push_back(std::thread(worker));
+    }
+    catch (std::system_error const &) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapInternal::runPNGTasks: can not create a new thread\n"));
+      break;
+    }
+  }
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+}
+
 /** Internal: helper function to create a PNG knowing the ihdr, image zone
     and the palette zone(indexed bitmap)
+
+    The image is made of rows of lineWidth bytes: a filter type byte
+    followed by the row data. If bytesPerPixel is not null, the rows
+    can be filtered (this must not be used for indexed bitmaps).
+
+    The image is compressed by bands of rows: when several threads are
+    allowed, each band is compressed in its own thread, the result is
+    then stored in one zlib stream.
  */
 static bool createPNGFile(unsigned char const *ihdr, unsigned ihdrSize,
-                          unsigned char const *image, unsigned imageSize,
+                          unsigned char const *image, unsigned imageSize, unsigned lineWidth, unsigned bytesPerPixel,
                           unsigned char const *palette, unsigned paletteSize,
-                          librevenge::RVNGBinaryData &data)
+                          librevenge::RVNGBinaryData &data, MWAWDocument::ParseOptions const &options)
 {
+  if (!image || !lineWidth || imageSize%lineWidth) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmapInternal::createPNGFile: the image size seems bad\n"));
+    return false;
+  }
+  int const level=std::max(-1, std::min(9, options.getPNGCompressionLevel()));
+  int strategy=Z_DEFAULT_STRATEGY;
+  switch (options.getPNGStrategy()) {
+  case MWAWDocument::ParseOptions::PNG_Filtered:
+    strategy=Z_FILTERED;
+    break;
+  case MWAWDocument::ParseOptions::PNG_RLE:
+    strategy=Z_RLE;
+    break;
+  case MWAWDocument::ParseOptions::PNG_HuffmanOnly:
+    strategy=Z_HUFFMAN_ONLY;
+    break;
+  case MWAWDocument::ParseOptions::PNG_Default:
+#if !defined(__clang__)
+  default:
+#endif
+    break;
+  }
+
+  // split the big images in bands of rows of around 128k, the small
+  // images are compressed in the calling thread as creating the threads
+  // would cost more than the compression
+  int const numThreads=imageSize>=1024*1024 ? options.getPNGNumThreads() : 1;
+  unsigned const numRows=imageSize/lineWidth;
+  unsigned bandRows=numRows;
+  if (numThreads>1)
+    bandRows=std::max(1u, (128*1024+lineWidth-1)/lineWidth);
+  std::vector<PNGBand> bands;
+  for (unsigned row=0; row<numRows; row+=bandRows)
+    bands.push_back(PNGBand(row*lineWidth, std::min(numRows, row+bandRows)*lineWidth));
+
+  // filter the rows if needed
+  std::unique_ptr<unsigned char[]> filteredImage;
+  if (options.usePNGAdaptiveFiltering() && bytesPerPixel && lineWidth>1) {
+    filteredImage.reset(new unsigned char[imageSize]);
+    unsigned const rowSize=lineWidth-1;
+    runPNGTasks(bands.size(), numThreads, [&](size_t id) {
+      std::vector<unsigned char> tmp(5*size_t(rowSize));
+      for (unsigned pos=bands[id].m_begin; pos<bands[id].m_end; pos+=lineWidth)
+        filterPNGRow(image+pos+1, pos ? image+pos+1-lineWidth : nullptr, rowSize, bytesPerPixel, filteredImage.get()+pos, tmp.data());
+    });
+    image=filteredImage.get();
+  }
+
+  // now compress the picture
+  runPNGTasks(bands.size(), numThreads, [&](size_t id) {
+    deflatePNGBand(image, bands[id], level, strategy, id+1==bands.size());
+  });
+
+  // the zlib header: deflate with a 32k window and the compression level
+  int const flevel=level==1 ? 0 : (level>=2 && level<=5) ? 1 : (level==-1 || level==6) ? 2 : level==0 ? 0 : 3;
+  unsigned const cmf=0x78;
+  unsigned flg=unsigned(flevel)<<6;
+  flg+=31-((cmf<<8)+flg)%31;
+  std::vector<unsigned char> idatBuffer;
+  idatBuffer.push_back(static_cast<unsigned char>(cmf));
+  idatBuffer.push_back(static_cast<unsigned char>(flg));
+  uLong adler=adler32(0, nullptr, 0);
+  for (auto const &band : bands) {
+    if (!band.m_ok) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapInternal::createPNGFile: can not compress a band\n"));
+      return false;
+    }
+    idatBuffer.insert(idatBuffer.end(), band.m_data.begin(), band.m_data.end());
+    adler=adler32_combine(adler, band.m_adler, z_off_t(band.m_end-band.m_begin));
+  }
+  unsigned char buf4[4];
+  writeBEU32(buf4, unsigned(adler));
+  idatBuffer.insert(idatBuffer.end(), buf4, buf4+4);
+
   unsigned char const signature[] = {
     /* PNG signature */
     0x89, 0x50, 0x4e, 0x47,
@@ -100,46 +403,13 @@ static bool createPNGFile(unsigned char const *ihdr, unsigned ihdrSize,
     addChunkInPNG(0x49484452 /* IHDR*/, ihdr, ihdrSize, data);
   if (palette && paletteSize)
     addChunkInPNG(0x504C5445 /*PLTE*/, palette, paletteSize, data);
-  // now compress the picture
-  const unsigned tmpBufSize = 128 * 1024;
-  std::unique_ptr<unsigned char[]> tmpBuffer{new unsigned char[tmpBufSize]};
-  std::vector<unsigned char> idatBuffer;
-
-  z_stream strm;
-  strm.zalloc = nullptr;
-  strm.zfree = nullptr;
-  strm.next_in = const_cast<unsigned char *>(image);
-  strm.avail_in = imageSize;
-  strm.next_out = tmpBuffer.get();
-  strm.avail_out = tmpBufSize;
-  strm.total_in = strm.total_out=0;
-
-  if (deflateInit(&strm, Z_RLE)!=Z_OK) return false;
-  while (strm.avail_in != 0) {
-    if (deflate(&strm, Z_NO_FLUSH)!=Z_OK) return false;
-    if (strm.avail_out == 0) {
-      idatBuffer.insert(idatBuffer.end(), tmpBuffer.get(), tmpBuffer.get() + tmpBufSize);
-      strm.next_out = tmpBuffer.get();
-      strm.avail_out = tmpBufSize;
-    }
-  }
-  while (deflate(&strm, Z_FINISH)==Z_OK) {
-    if (strm.avail_out == 0) {
-      idatBuffer.insert(idatBuffer.end(), tmpBuffer.get(), tmpBuffer.get() + tmpBufSize);
-      strm.next_out = tmpBuffer.get();
-      strm.avail_out = tmpBufSize;
-    }
-  }
-  idatBuffer.insert(idatBuffer.end(), tmpBuffer.get(), tmpBuffer.get() + tmpBufSize - strm.avail_out);
-  deflateEnd(&strm);
-
   addChunkInPNG(0x49444154/*IDAT*/, idatBuffer.data(), unsigned(idatBuffer.size()), data);
   addChunkInPNG(0x49454e44 /*IEND*/, nullptr, 0, data);
   return true;
 }
 
 //! Internal: fonction to create a PNG image from a true color bitmap (need zlib)
-static bool getPNGData(MWAWPictBitmapContainer<MWAWColor> const &orig, librevenge::RVNGBinaryData &data, bool useAlpha)
+static bool getPNGData(MWAWPictBitmapContainer<MWAWColor> const &orig, librevenge::RVNGBinaryData &data, bool useAlpha, MWAWDocument::ParseOptions const &options)
 {
   MWAWVec2i sz = orig.size();
   if (sz[0] <= 0 || sz[0] > 10000 || sz[1] <= 0) {
@@ -184,12 +454,12 @@ static bool getPNGData(MWAWPictBitmapContainer<MWAWColor> const &orig, libreveng
         *(imagePtr++)=static_cast<unsigned char>((col>>24)&0xFF);
     }
   }
-  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, nullptr, 0, data);
+  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, lineWidth, numBytes, nullptr, 0, data, options);
 }
 
 //! Internal: fonction to create a PNG image from a indexed bitmap (need zlib)
 template <class T>
-bool getPNGData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, std::vector<MWAWColor> const &indexedColor)
+bool getPNGData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, std::vector<MWAWColor> const &indexedColor, MWAWDocument::ParseOptions const &options)
 {
   MWAWVec2i sz = orig.size();
   auto nColors = int(indexedColor.size());
@@ -240,7 +510,7 @@ bool getPNGData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryDa
     }
   }
   if (!useIndex)
-    return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, nullptr, 0, data);
+    return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, lineWidth, numBytes, nullptr, 0, data, options);
   std::unique_ptr<unsigned char[]> paletteBuffer{new unsigned char[3*unsigned(nColors)]};
   unsigned char *palettePtr=paletteBuffer.get();
   for (auto const &color : indexedColor) {
@@ -249,12 +519,12 @@ bool getPNGData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryDa
     *(palettePtr++)=static_cast<unsigned char>((col>>8)&0xFF);
     *(palettePtr++)=static_cast<unsigned char>(col&0xFF);
   }
-  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, paletteBuffer.get(), 3*unsigned(nColors), data);
+  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, lineWidth, 0, paletteBuffer.get(), 3*unsigned(nColors), data, options);
 }
 
 //! Internal: helper function to create a 2 color PNG file
 template <class T>
-bool getPNG1Data(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, T white)
+bool getPNG1Data(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, T white, MWAWDocument::ParseOptions const &options)
 {
   MWAWVec2i sz = orig.size();
   if (sz[0] <= 0 || sz[1] <= 0) return false;
@@ -308,7 +578,47 @@ bool getPNG1Data(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryD
     *(palettePtr++)=static_cast<unsigned char>((col>>8)&0xFF);
     *(palettePtr++)=static_cast<unsigned char>(col&0xFF);
   }
-  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, paletteBuffer.get(), 3*unsigned(nColors), data);
+  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, lineWidth, 0, paletteBuffer.get(), 3*unsigned(nColors), data, options);
+}
+
+//! Internal: function to create a 2 color PNG file from a black and white bitmap: the rows are already packed
+static bool getPNG1Data(MWAWPictBitmapContainerBool const &orig, librevenge::RVNGBinaryData &data, MWAWDocument::ParseOptions const &options)
+{
+  MWAWVec2i sz = orig.size();
+  if (sz[0] <= 0 || sz[1] <= 0) return false;
+
+  unsigned char ihdr[] = {
+    /* IHDR -- Image header */
+    0, 0, 0, 0,           // width
+    0, 0, 0, 0,           // height
+    1,                    // bit depth
+    3,                    // 3: indexed
+    0,                    // compression method: 0=deflate
+    0,                    // filter method: 0=adaptative
+    0                     // interlace method: 0=none
+  };
+  writeBEU32(ihdr, unsigned(sz[0]));
+  writeBEU32(ihdr+4, unsigned(sz[1]));
+
+  auto const rowBytes=unsigned(orig.rowBytes());
+  unsigned const lineWidth=1+rowBytes;
+  unsigned const imageSize=lineWidth*unsigned(sz[1]);
+  if (!rowBytes || imageSize/lineWidth<unsigned(sz[1])) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmapInternal:getPNG1Data: the idat chunk is too big\n"));
+    return false;
+  }
+
+  // create the image data: a filter byte followed by the packed row
+  std::unique_ptr<unsigned char[]> imageBuffer{new unsigned char[imageSize]};
+  unsigned char *imagePtr=imageBuffer.get();
+  for (int j = 0; j < sz[1]; j++) {
+    *(imagePtr++) = 0; // 0: means none
+    std::memcpy(imagePtr, orig.getRowPacked(j), rowBytes);
+    imagePtr+=rowBytes;
+  }
+  // a black and white palette: 0 is white, 1 is black
+  unsigned char const palette[]= {0xff, 0xff, 0xff, 0, 0, 0};
+  return createPNGFile(ihdr, unsigned(MWAW_N_ELEMENTS(ihdr)), imageBuffer.get(), imageSize, lineWidth, 0, palette, unsigned(MWAW_N_ELEMENTS(palette)), data, options);
 }
 #else
 //! Internal: helper function to create a PBM
@@ -341,6 +651,22 @@ bool getPBMData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryDa
   return true;
 }
 
+//! Internal: helper function to create a PBM from a black and white bitmap: the rows are already packed
+static bool getPBMData(MWAWPictBitmapContainerBool const &orig, librevenge::RVNGBinaryData &data)
+{
+  MWAWVec2i sz = orig.size();
+  if (sz[0] <= 0 || sz[1] <= 0) return false;
+
+  data.clear();
+  std::stringstream f;
+  f << "P4\n" << sz[0] << " " << sz[1] << "\n";
+  std::string const &header = f.str();
+  data.append(reinterpret_cast<const unsigned char *>(header.c_str()), header.size());
+  for (int j = 0; j < sz[1]; j++)
+    data.append(orig.getRowPacked(j), size_t(orig.rowBytes()));
+  return true;
+}
+
 //! Internal: helper function to create a PPM
 template <class T>
 bool getPPMData(MWAWPictBitmapContainer<T> const &orig, librevenge::RVNGBinaryData &data, std::vector<MWAWColor> const &indexedColor)
@@ -489,28 +815,164 @@ static bool getBMPData(MWAWPictBitmapContainer<MWAWColor> const &orig, libreveng
   return true;
 }
 #endif
+
+//! Internal: helper function to create the file corresponding to an indexed bitmap
+template <class T>
+bool getIndexedFileData(MWAWPictBitmapContainer<T> const &orig, std::vector<MWAWColor> const &colors, librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options)
+{
+#ifdef USE_ZLIB
+  if (colors.size() && getPNGData<T>(orig,result,colors,options)) return true;
+  return getPNG1Data<T>(orig,result,T(0),options);
+#else
+  (void) options;
+  if (colors.size() && getPPMData<T>(orig,result,colors)) return true;
+  return getPBMData<T>(orig,result,T(0));
+#endif
 }
 
-MWAWPictBitmapContainerBool::~MWAWPictBitmapContainerBool()
+//! Internal: helper function to compute the average color of an indexed bitmap
+template <class T>
+MWAWColor getAverageColor(MWAWPictBitmapContainer<T> const &orig, std::vector<MWAWColor> const &colors)
 {
+  auto const &sz=orig.size();
+  if (sz[0] <= 0 || sz[1] <= 0) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmapIndexed::getAverageColor: called on empty picture\n"));
+    return MWAWColor::black();
+  }
+  // first count the number of pixels of each index
+  std::vector<unsigned long> numPixels(size_t(std::numeric_limits<T>::max())+1, 0);
+  for (int j = 0; j < sz[1]; j++) {
+    T const *row = orig.getRow(j);
+    for (int i = 0; i < sz[0]; i++)
+      ++numPixels[size_t(row[i])];
+  }
+  unsigned long n[]= {0,0,0,0};
+  size_t const nCol=std::min(colors.size(), numPixels.size());
+  for (size_t id=0; id<nCol; ++id) {
+    if (!numPixels[id]) continue;
+    n[0]+=numPixels[id]*colors[id].getRed();
+    n[1]+=numPixels[id]*colors[id].getGreen();
+    n[2]+=numPixels[id]*colors[id].getBlue();
+    n[3]+=numPixels[id]*colors[id].getAlpha();
+  }
+  return MWAWColor((unsigned char)(n[0]/(unsigned long)(sz[0]*sz[1])),
+                   (unsigned char)(n[1]/(unsigned long)(sz[0]*sz[1])),
+                   (unsigned char)(n[2]/(unsigned long)(sz[0]*sz[1])),
+                   (unsigned char)(n[3]/(unsigned long)(sz[0]*sz[1])));
+}
 }
 
 MWAWPictBitmap::~MWAWPictBitmap()
 {
 }
+
+bool MWAWPictBitmap::decodeRawData(librevenge::RVNGBinaryData const &raw, librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options)
+{
+  unsigned char const *data=raw.getDataBuffer();
+  unsigned long const dataSize=raw.size();
+  unsigned const headerSize=MWAWPictBitmapInternal::s_rawHeaderSize;
+  if (!data || dataSize<headerSize || std::memcmp(data, "MRAW", 4)!=0) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmap::decodeRawData: the data does not begin with a raw header\n"));
+    return false;
+  }
+  unsigned const width=MWAWPictBitmapInternal::readBEU32(data+4);
+  unsigned const height=MWAWPictBitmapInternal::readBEU32(data+8);
+  unsigned const bitsByPixel=(unsigned(data[12])<<8) | unsigned(data[13]);
+  unsigned const numColors=MWAWPictBitmapInternal::readBEU32(data+16);
+  if (width==0 || height==0 || width>unsigned(std::numeric_limits<int>::max()/32) || height>unsigned(std::numeric_limits<int>::max()) ||
+      (bitsByPixel!=1 && bitsByPixel!=8 && bitsByPixel!=16 && bitsByPixel!=24 && bitsByPixel!=32) ||
+      numColors>(dataSize-headerSize)/4) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmap::decodeRawData: the header seems bad\n"));
+    return false;
+  }
+  size_t const rowSize=MWAWPictBitmapInternal::getRawRowSize(width, bitsByPixel);
+  if ((dataSize-headerSize-4*numColors)/rowSize<height) {
+    MWAW_DEBUG_MSG(("MWAWPictBitmap::decodeRawData: the data seems too short\n"));
+    return false;
+  }
+  unsigned char const *ptr=data+headerSize;
+  std::vector<MWAWColor> colors;
+  for (unsigned c=0; c<numColors; ++c, ptr+=4)
+    colors.push_back(MWAWColor(ptr[0], ptr[1], ptr[2], ptr[3]));
+  MWAWVec2i const sz(static_cast<int>(width), static_cast<int>(height));
+  std::unique_ptr<MWAWPictBitmap> bitmap;
+  switch (bitsByPixel) {
+  case 1: {
+    auto *bitmapBW=new MWAWPictBitmapBW(sz);
+    bitmap.reset(bitmapBW);
+    for (int j=0; j<sz[1]; ++j, ptr+=rowSize)
+      bitmapBW->setRowPacked(j, ptr, ptr+rowSize);
+    break;
+  }
+  case 8:
+  case 16: {
+    auto *bitmapIndexed=new MWAWPictBitmapIndexed(sz);
+    bitmap.reset(bitmapIndexed);
+    bitmapIndexed->setColors(colors);
+    std::vector<unsigned> row(static_cast<size_t>(width));
+    for (int j=0; j<sz[1]; ++j) {
+      for (auto &value : row) {
+        value=bitsByPixel==8 ? unsigned(*(ptr++)) : (unsigned(ptr[0])<<8) | unsigned(ptr[1]);
+        if (bitsByPixel==16) ptr+=2;
+      }
+      bitmapIndexed->setRow(j, row.data());
+    }
+    break;
+  }
+  default: {
+    auto *bitmapColor=new MWAWPictBitmapColor(sz, bitsByPixel==32);
+    bitmap.reset(bitmapColor);
+    std::vector<MWAWColor> row(static_cast<size_t>(width));
+    for (int j=0; j<sz[1]; ++j) {
+      for (auto &color : row) {
+        color=MWAWColor(ptr[0], ptr[1], ptr[2], bitsByPixel==32 ? ptr[3] : 255);
+        ptr+=bitsByPixel/8;
+      }
+      bitmapColor->setRow(j, row.data());
+    }
+    break;
+  }
+  }
+  result.clear();
+  return bitmap->createFileData(result, options);
+}
+
+void MWAWPictBitmap::encodeRawData(MWAWEmbeddedObject &object, MWAWDocument::ParseOptions const &options)
+{
+  for (size_t i=0; i<object.m_dataList.size() && i<object.m_typeList.size(); ++i) {
+    if (object.m_typeList[i]!="image/mwaw-raw") continue;
+    librevenge::RVNGBinaryData data;
+    if (!decodeRawData(object.m_dataList[i], data, options)) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmap::encodeRawData: can not encode a bitmap\n"));
+      data.clear();
+    }
+    object.m_dataList[i]=data;
+    object.m_typeList[i]="image/pict";
+  }
+}
 ////////////////////////////////////////////////////////////
 // BW bitmap
 ////////////////////////////////////////////////////////////
 
-bool MWAWPictBitmapBW::createFileData(librevenge::RVNGBinaryData &result) const
+bool MWAWPictBitmapBW::createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const
 {
 #ifdef USE_ZLIB
-  return MWAWPictBitmapInternal::getPNG1Data<bool>(m_data,result,false);
+  return MWAWPictBitmapInternal::getPNG1Data(m_data,result,options);
 #else
-  return MWAWPictBitmapInternal::getPBMData<bool>(m_data,result,false);
+  (void) options;
+  return MWAWPictBitmapInternal::getPBMData(m_data,result);
 #endif
 }
 
+bool MWAWPictBitmapBW::createRawData(librevenge::RVNGBinaryData &result) const
+{
+  if (!MWAWPictBitmapInternal::addRawHeader(m_data.size(), 1, std::vector<MWAWColor>(), result))
+    return false;
+  for (int j = 0; j < m_data.size()[1]; j++)
+    result.append(m_data.getRowPacked(j), size_t(m_data.rowBytes()));
+  return true;
+}
+
 MWAWColor MWAWPictBitmapBW::getAverageColor() const
 {
   auto const &sz=m_data.size();
@@ -518,12 +980,17 @@ MWAWColor MWAWPictBitmapBW::getAverageColor() const
     MWAW_DEBUG_MSG(("MWAWPictBitmapBW::getAverageColor: called on empty picture\n"));
     return MWAWColor::black();
   }
-  unsigned long n=0;
+  // count the black pixels, the unused bits are always 0
+  unsigned long numBlack=0;
+  int const rowBytes=m_data.rowBytes();
   for (int j = 0; j < sz[1]; j++) {
-    bool const *row = getRow(j);
-    for (int i = 0; i < sz[0]; i++)
-      if (!row[i]) ++n;
+    unsigned char const *row = getRowPacked(j);
+    for (int i = 0; i < rowBytes; i++) {
+      for (unsigned char v=row[i]; v; v=static_cast<unsigned char>(v&(v-1)))
+        ++numBlack;
+    }
   }
+  unsigned long const n=(unsigned long)(sz[0]*sz[1])-numBlack;
   unsigned char c=(unsigned char)((255*n)/(unsigned long)(sz[0]*sz[1]));
   return MWAWColor(c,c,c);
 }
@@ -532,16 +999,39 @@ MWAWColor MWAWPictBitmapBW::getAverageColor() const
 // Color bitmap
 ////////////////////////////////////////////////////////////
 
-bool MWAWPictBitmapColor::createFileData(librevenge::RVNGBinaryData &result) const
+bool MWAWPictBitmapColor::createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const
 {
 #ifdef USE_ZLIB
-  return MWAWPictBitmapInternal::getPNGData(m_data,result,m_hasAlpha);
+  return MWAWPictBitmapInternal::getPNGData(m_data,result,m_hasAlpha,options);
 #else
+  (void) options;
   if (m_hasAlpha) return MWAWPictBitmapInternal::getBMPData(m_data,result);
   return MWAWPictBitmapInternal::getPPMData(m_data,result);
 #endif
 }
 
+bool MWAWPictBitmapColor::createRawData(librevenge::RVNGBinaryData &result) const
+{
+  auto const &sz=m_data.size();
+  unsigned const numBytes=m_hasAlpha ? 4 : 3;
+  if (!MWAWPictBitmapInternal::addRawHeader(sz, 8*numBytes, std::vector<MWAWColor>(), result))
+    return false;
+  std::vector<unsigned char> row(static_cast<size_t>(sz[0])*numBytes);
+  for (int j = 0; j < sz[1]; j++) {
+    MWAWColor const *colors = m_data.getRow(j);
+    unsigned char *ptr=row.data();
+    for (int i = 0; i < sz[0]; i++) {
+      *(ptr++)=colors[i].getRed();
+      *(ptr++)=colors[i].getGreen();
+      *(ptr++)=colors[i].getBlue();
+      if (m_hasAlpha)
+        *(ptr++)=colors[i].getAlpha();
+    }
+    result.append(row.data(), row.size());
+  }
+  return true;
+}
+
 MWAWColor MWAWPictBitmapColor::getAverageColor() const
 {
   auto const &sz=m_data.size();
@@ -569,40 +1059,68 @@ MWAWColor MWAWPictBitmapColor::getAverageColor() const
 // Indexed bitmap
 ////////////////////////////////////////////////////////////
 
-bool MWAWPictBitmapIndexed::createFileData(librevenge::RVNGBinaryData &result) const
+int MWAWPictBitmapIndexed::cmp(MWAWPict const &a) const
 {
-#ifdef USE_ZLIB
-  if (m_colors.size() && MWAWPictBitmapInternal::getPNGData<int>(m_data,result,m_colors)) return true;
-  return MWAWPictBitmapInternal::getPNG1Data<int>(m_data,result,0);
-#else
-  if (m_colors.size() && MWAWPictBitmapInternal::getPPMData<int>(m_data,result,m_colors)) return true;
-  return MWAWPictBitmapInternal::getPBMData<int>(m_data,result,0);
-#endif
-}
+  int diff = MWAWPictBitmap::cmp(a);
+  if (diff) return diff;
+  auto const &aPict = static_cast<MWAWPictBitmapIndexed const &>(a);
 
-MWAWColor MWAWPictBitmapIndexed::getAverageColor() const
-{
-  auto const &sz=m_data.size();
-  if (sz[0] <= 0 || sz[1] <= 0) {
-    MWAW_DEBUG_MSG(("MWAWPictBitmapIndexed::getAverageColor: called on empty picture\n"));
-    return MWAWColor::black();
+  diff=int(m_colors.size())-int(aPict.m_colors.size());
+  if (diff) return (diff < 0) ? -1 : 1;
+  for (size_t c=0; c < m_colors.size(); c++) {
+    if (m_colors[c] < aPict.m_colors[c])
+      return 1;
+    if (m_colors[c] > aPict.m_colors[c])
+      return -1;
   }
-  unsigned long n[]= {0,0,0,0};
-  size_t nCol=m_colors.size();
-  for (int j = 0; j < sz[1]; j++) {
-    int const *row = getRow(j);
-    for (int i = 0; i < sz[0]; i++) {
-      size_t const id=size_t(row[i]);
-      if (id >= nCol) continue;
-      n[0]+=m_colors[id].getRed();
-      n[1]+=m_colors[id].getGreen();
-      n[2]+=m_colors[id].getBlue();
-      n[3]+=m_colors[id].getAlpha();
+  if (!m_data16 && !aPict.m_data16)
+    return m_data8->cmp(*aPict.m_data8);
+  if (m_data16 && aPict.m_data16)
+    return m_data16->cmp(*aPict.m_data16);
+  // the two bitmaps do not use the same storage, compare the indices
+  diff = size().cmpY(aPict.size());
+  if (diff) return diff;
+  if (!valid()) return aPict.valid() ? 1 : 0;
+  if (!aPict.valid()) return -1;
+  for (int j=0; j<size()[1]; ++j) {
+    for (int i=0; i<size()[0]; ++i) {
+      diff=get(i,j)-aPict.get(i,j);
+      if (diff) return (diff < 0) ? -1 : 1;
     }
   }
-  return MWAWColor((unsigned char)(n[0]/(unsigned long)(sz[0]*sz[1])),
-                   (unsigned char)(n[1]/(unsigned long)(sz[0]*sz[1])),
-                   (unsigned char)(n[2]/(unsigned long)(sz[0]*sz[1])),
-                   (unsigned char)(n[3]/(unsigned long)(sz[0]*sz[1])));
+  return 0;
+}
+
+void MWAWPictBitmapIndexed::convertTo16Bits()
+{
+  if (m_data16 || !m_data8) return;
+  MWAWVec2i const sz=m_data8->size();
+  m_data16.reset(new MWAWPictBitmapContainer<uint16_t>(sz));
+  if (m_data8->ok() && m_data16->ok()) {
+    for (int j=0; j<sz[1]; ++j)
+      m_data16->setRow(j, m_data8->getRow(j));
+  }
+  m_data8.reset();
+}
+
+bool MWAWPictBitmapIndexed::createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const
+{
+  if (m_data16)
+    return MWAWPictBitmapInternal::getIndexedFileData(*m_data16, m_colors, result, options);
+  return MWAWPictBitmapInternal::getIndexedFileData(*m_data8, m_colors, result, options);
+}
+
+bool MWAWPictBitmapIndexed::createRawData(librevenge::RVNGBinaryData &result) const
+{
+  if (m_data16)
+    return MWAWPictBitmapInternal::getIndexedRawData(*m_data16, m_colors, result);
+  return MWAWPictBitmapInternal::getIndexedRawData(*m_data8, m_colors, result);
+}
+
+MWAWColor MWAWPictBitmapIndexed::getAverageColor() const
+{
+  if (m_data16)
+    return MWAWPictBitmapInternal::getAverageColor(*m_data16, m_colors);
+  return MWAWPictBitmapInternal::getAverageColor(*m_data8, m_colors);
 }
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -38,8 +38,12 @@
 #  define MWAW_PICT_BITMAP
 
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
+#include <libmwaw/libmwaw.hxx>
+
 #include "libmwaw_internal.hxx"
 #include "MWAWDebug.hxx"
 #include "MWAWPict.hxx"
@@ -161,47 +165,143 @@ protected:
   T *m_data;
 };
 
-//! a bool container with a function to put packed row
-class MWAWPictBitmapContainerBool final : public MWAWPictBitmapContainer<bool>
+/** \brief a container to store a black and white bitmap
+
+    The rows are stored packed: 8 pixels by byte, the first pixel
+    corresponding to the high bit, each row beginning on a new byte. So
+    the packed rows of a PICT/MacPaint bitmap can be copied directly and
+    the PNG/PBM encoders only need to copy each row.
+ */
+class MWAWPictBitmapContainerBool
 {
 public:
-  //! constructor
+  //! constructor given size
   explicit MWAWPictBitmapContainerBool(MWAWVec2i const &sz)
-    : MWAWPictBitmapContainer<bool>(sz)
+    : m_size(sz)
+    , m_rowBytes(sz[0]>0 ? (sz[0]+7)/8 : 0)
+    , m_data()
   {
+    if (m_size[0]<=0 || m_size[1]<=0) return;
+    m_data.resize(size_t(m_rowBytes)*size_t(m_size[1]), 0);
   }
-  //! destructor
-  ~MWAWPictBitmapContainerBool() final;
+
+  //! returns ok, if the m_data is allocated
+  bool ok() const
+  {
+    return !m_data.empty();
+  }
+
   //! a comparison operator
   int cmp(MWAWPictBitmapContainerBool const &orig) const
   {
     int diff = m_size.cmpY(orig.m_size);
     if (diff) return diff;
-    if (!m_data) return orig.m_data ? 1 : 0;
-    if (!orig.m_data) return -1;
-    for (int i=0; i < m_size[0]*m_size[1]; i++) {
-      if (m_data[i] == orig.m_data[i]) continue;
-      return m_data[i] ? 1 : -1;
-    }
+    if (m_data.empty()) return orig.m_data.empty() ? 0 : 1;
+    if (orig.m_data.empty()) return -1;
+    // the unused bits are always 0, so this gives the same order as a pixel comparison
+    diff = std::memcmp(m_data.data(), orig.m_data.data(), m_data.size());
+    if (diff) return (diff < 0) ? -1 : 1;
     return 0;
   }
+  //! return the array size
+  MWAWVec2i const &size() const
+  {
+    return m_size;
+  }
+  //! gets the number of row
+  int numRows() const
+  {
+    return m_size[0];
+  }
+  //! gets the number of column
+  int numColumns() const
+  {
+    return m_size[1];
+  }
+  //! returns the number of bytes used to store a row
+  int rowBytes() const
+  {
+    return m_rowBytes;
+  }
 
-  //! allows to use packed m_data
+  //! accessor of a cell m_data
+  bool get(int i, int j) const
+  {
+    if (m_data.empty() || i<0 || i >= m_size[0] || j<0 || j >= m_size[1])
+      throw libmwaw::GenericException();
+    return (m_data[size_t(j)*size_t(m_rowBytes)+size_t(i>>3)]&(0x80>>(i&7)))!=0;
+  }
+  //! accessor of a packed row m_data
+  unsigned char const *getRowPacked(int j) const
+  {
+    if (m_data.empty() || j<0 || j >= m_size[1])
+      throw libmwaw::GenericException();
+    return m_data.data()+size_t(j)*size_t(m_rowBytes);
+  }
+
+  //! sets a cell m_data
+  void set(int i, int j, bool v)
+  {
+    if (m_data.empty() || i<0 || i >= m_size[0] || j<0 || j >= m_size[1]) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapContainerBool::set: call with bad coordinate %d %d\n", i, j));
+      return;
+    }
+    unsigned char &value=m_data[size_t(j)*size_t(m_rowBytes)+size_t(i>>3)];
+    auto const mask=static_cast<unsigned char>(0x80>>(i&7));
+    if (v)
+      value=static_cast<unsigned char>(value|mask);
+    else
+      value=static_cast<unsigned char>(value&~mask);
+  }
+
+  //! sets a line of m_data
+  void setRow(int j, bool const *val)
+  {
+    if (m_data.empty() || j<0 || j >= m_size[1]) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapContainerBool::setRow: call with bad coordinate %d\n", j));
+      return;
+    }
+    unsigned char *row=m_data.data()+size_t(j)*size_t(m_rowBytes);
+    std::memset(row, 0, size_t(m_rowBytes));
+    for (int i = 0; i < m_size[0]; i++) {
+      if (val[i]) row[i>>3]=static_cast<unsigned char>(row[i>>3]|(0x80>>(i&7)));
+    }
+  }
+
+  //! sets a column of m_data
+  void setColumn(int i, bool const *val)
+  {
+    if (m_data.empty() || i<0 || i >= m_size[0]) {
+      MWAW_DEBUG_MSG(("MWAWPictBitmapContainerBool::setColumn: call with bad coordinate %d\n", i));
+      return;
+    }
+    for (int j = 0; j < m_size[1]; j++) set(i, j, val[j]);
+  }
+
+  //! allows to use packed m_data: copies the row, the missing bytes are set to 0
   void setRowPacked(int j, unsigned char const *val, unsigned char const *end)
   {
-    if (m_data == nullptr || j<0 || j >= m_size[1] || val >= end) {
+    if (m_data.empty() || j<0 || j >= m_size[1] || val >= end) {
       MWAW_DEBUG_MSG(("MWAWPictBitmapContainerBool::setRowPacked: call with bad coordinate %d\n", j));
       return;
     }
-    for (int i = 0, ind = j*m_size[0]; i < m_size[0];) {
-      unsigned char v = (val < end) ? *(val++) : 0;
-      unsigned char mask = 0x80;
-      for (int p = 0; p < 8 && i < m_size[0]; i++, p++, ind++) {
-        m_data[ind] = ((v&mask) != 0);
-        mask = static_cast<unsigned char>(mask >> 1);
-      }
-    }
+    unsigned char *row=m_data.data()+size_t(j)*size_t(m_rowBytes);
+    size_t const numBytes=std::min(size_t(m_rowBytes), size_t(end-val));
+    std::memcpy(row, val, numBytes);
+    if (numBytes < size_t(m_rowBytes))
+      std::memset(row+numBytes, 0, size_t(m_rowBytes)-numBytes);
+    // reset the unused bits
+    if (m_size[0]&7)
+      row[m_rowBytes-1]=static_cast<unsigned char>(row[m_rowBytes-1]&(0xFF00>>(m_size[0]&7)));
   }
+
+protected:
+  //! the size
+  MWAWVec2i m_size;
+  //! the number of bytes used to store a row
+  int m_rowBytes;
+  //! the packed rows: 8 pixels by byte, the unused bits of the last byte are 0
+  std::vector<unsigned char> m_data;
 };
 
 //! Generic class used to construct bitmap
@@ -221,13 +321,19 @@ public:
   //! returns the picture subtype
   virtual SubType getSubType() const = 0;
 
-  //! returns the final picture
+  /** returns the final picture: the pixels are stored in a
+      "image/mwaw-raw" picture, the listeners encode them when they
+      send the picture, see encodeRawData */
   bool getBinary(MWAWEmbeddedObject &picture) const override
   {
     if (!valid()) return false;
 
     librevenge::RVNGBinaryData data;
-    createFileData(data);
+    if (createRawData(data)) {
+      picture=MWAWEmbeddedObject(data, "image/mwaw-raw");
+      return true;
+    }
+    createFileData(data, MWAWDocument::ParseOptions());
     picture=MWAWEmbeddedObject(data, "image/pict");
     return true;
   }
@@ -240,6 +346,10 @@ public:
 
   //! returns the average color
   virtual MWAWColor getAverageColor() const = 0;
+  //! encodes a "image/mwaw-raw" data in a picture file using the PNG options of options
+  static bool decodeRawData(librevenge::RVNGBinaryData const &raw, librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options);
+  //! replaces the "image/mwaw-raw" representations of an object by their picture files, see decodeRawData
+  static void encodeRawData(MWAWEmbeddedObject &object, MWAWDocument::ParseOptions const &options);
   /** a virtual function used to obtain a strict order,
   must be redefined in the subs class */
   int cmp(MWAWPict const &a) const override
@@ -257,7 +367,9 @@ public:
 
 protected:
   //! abstract function which creates the result file
-  virtual bool createFileData(librevenge::RVNGBinaryData &result) const = 0;
+  virtual bool createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const = 0;
+  //! abstract function which stores the pixels in a "image/mwaw-raw" data
+  virtual bool createRawData(librevenge::RVNGBinaryData &result) const = 0;
 
   //! protected constructor: use check to construct a picture
   explicit MWAWPictBitmap(MWAWVec2i const &sz)
@@ -320,10 +432,15 @@ public:
   {
     return m_data.get(i,j);
   }
-  //! returns the cells content of a row
-  bool const *getRow(int j) const
+  //! returns the number of bytes used to store a packed row
+  int rowBytes() const
   {
-    return m_data.getRow(j);
+    return m_data.rowBytes();
+  }
+  //! returns the cells content of a row: 8 pixels by byte, the first pixel corresponding to the high bit
+  unsigned char const *getRowPacked(int j) const
+  {
+    return m_data.getRowPacked(j);
   }
   //! sets a cell contents
   void set(int i, int j, bool v)
@@ -350,13 +467,20 @@ public:
 
 protected:
   //! function which creates the result file
-  bool createFileData(librevenge::RVNGBinaryData &result) const final;
+  bool createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const final;
+  //! the function which stores the pixels in a "image/mwaw-raw" data
+  bool createRawData(librevenge::RVNGBinaryData &result) const final;
 
   //! the data
   MWAWPictBitmapContainerBool m_data;
 };
 
-/** a bitmap of int to store indexed bitmap */
+/** a bitmap of index to store indexed bitmap
+
+    The indices are stored in bytes while they are less than 256, ie.
+    for almost all palettes. When an index greater than 255 is set, the
+    data are converted to 16 bits indices.
+ */
 class MWAWPictBitmapIndexed final : public MWAWPictBitmap
 {
 public:
@@ -368,27 +492,12 @@ public:
 
   /** a virtual function used to obtain a strict order,
   must be redefined in the subs class */
-  int cmp(MWAWPict const &a) const final
-  {
-    int diff = MWAWPictBitmap::cmp(a);
-    if (diff) return diff;
-    auto const &aPict = static_cast<MWAWPictBitmapIndexed const &>(a);
-
-    diff=int(m_colors.size())-int(aPict.m_colors.size());
-    if (diff) return (diff < 0) ? -1 : 1;
-    for (size_t c=0; c < m_colors.size(); c++) {
-      if (m_colors[c] < aPict.m_colors[c])
-        return 1;
-      if (m_colors[c] > aPict.m_colors[c])
-        return -1;
-    }
-    return m_data.cmp(aPict.m_data);
-  }
+  int cmp(MWAWPict const &a) const final;
 
   //! returns true if the picture is valid
   bool valid() const final
   {
-    return m_data.ok();
+    return m_data16 ? m_data16->ok() : m_data8->ok();
   }
   //! returns the average color
   MWAWColor getAverageColor() const final;
@@ -396,7 +505,8 @@ public:
   //! the constructor
   explicit MWAWPictBitmapIndexed(MWAWVec2i const &sz)
     : MWAWPictBitmap(sz)
-    , m_data(sz)
+    , m_data8(new MWAWPictBitmapContainer<uint8_t>(sz))
+    , m_data16()
     , m_colors()
   {
   }
@@ -404,43 +514,60 @@ public:
   //! the picture size
   MWAWVec2i const &size() const
   {
-    return m_data.size();
+    return m_data16 ? m_data16->size() : m_data8->size();
   }
   //! the number of rows
   int numRows() const
   {
-    return m_data.numRows();
+    return size()[0];
   }
   //! the number of columns
   int numColumns() const
   {
-    return m_data.numColumns();
+    return size()[1];
   }
   //! returns a cell content
   int get(int i, int j) const
   {
-    return m_data.get(i,j);
-  }
-  //! returns the cells content of a row
-  int const *getRow(int j) const
-  {
-    return m_data.getRow(j);
+    return m_data16 ? int(m_data16->get(i,j)) : int(m_data8->get(i,j));
   }
 
   //! sets a cell contents
   void set(int i, int j, int v)
   {
-    m_data.set(i,j, v);
+    if (m_data16)
+      m_data16->set(i,j, getIndex16(v));
+    else if (v>=0 && v<=0xFF)
+      m_data8->set(i,j, uint8_t(v));
+    else {
+      convertTo16Bits();
+      m_data16->set(i,j, getIndex16(v));
+    }
   }
   //! sets all cell contents of a row
   template <class U> void setRow(int j, U const *val)
   {
-    m_data.setRow(j, val);
+    int const w=size()[0];
+    if (!m_data16) {
+      for (int i=0; i<w; ++i) {
+        if (int(val[i])>=0 && int(val[i])<=0xFF) continue;
+        convertTo16Bits();
+        break;
+      }
+    }
+    if (!m_data16) {
+      m_data8->setRow(j, val);
+      return;
+    }
+    std::vector<uint16_t> row(size_t(w > 0 ? w : 0));
+    for (int i=0; i<w; ++i) row[size_t(i)]=getIndex16(int(val[i]));
+    m_data16->setRow(j, row.data());
   }
   //! sets all cell contents of a column
   template <class U> void setColumn(int i, U const *val)
   {
-    m_data.setColumn(i, val);
+    int const h=size()[1];
+    for (int j=0; j<h; ++j) set(i, j, int(val[j]));
   }
 
   //! returns the array of indexed colors
@@ -456,10 +583,21 @@ public:
 
 protected:
   //! the function which creates the result file
-  bool createFileData(librevenge::RVNGBinaryData &result) const final;
+  bool createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const final;
+  //! the function which stores the pixels in a "image/mwaw-raw" data
+  bool createRawData(librevenge::RVNGBinaryData &result) const final;
+  //! converts the 8 bits indices in 16 bits indices
+  void convertTo16Bits();
+  //! returns a 16 bits index, the invalid values are replaced by 0xFFFF
+  static uint16_t getIndex16(int v)
+  {
+    return (v>=0 && v<=0xFFFF) ? uint16_t(v) : uint16_t(0xFFFF);
+  }
 
-  //! the m_data
-  MWAWPictBitmapContainer<int> m_data;
+  //! the data: the 8 bits indices (reset when the data are converted in 16 bits)
+  std::unique_ptr<MWAWPictBitmapContainer<uint8_t> > m_data8;
+  //! the data: the 16 bits indices, only created if an index is greater than 255
+  std::unique_ptr<MWAWPictBitmapContainer<uint16_t> > m_data16;
   //! the colors
   std::vector<MWAWColor> m_colors;
 };
@@ -551,7 +689,9 @@ public:
 
 protected:
   //! the function which creates the result file
-  bool createFileData(librevenge::RVNGBinaryData &result) const final;
+  bool createFileData(librevenge::RVNGBinaryData &result, MWAWDocument::ParseOptions const &options) const final;
+  //! the function which stores the pixels in a "image/mwaw-raw" data
+  bool createRawData(librevenge::RVNGBinaryData &result) const final;
 
   //! the data
   MWAWPictBitmapContainer<MWAWColor> m_data;
@@ -44,6 +44,7 @@
 #include "libmwaw_internal.hxx"
 #include "MWAWDebug.hxx"
 #include "MWAWInputStream.hxx"
+#include "MWAWPackBits.hxx"
 
 #include "MWAWPictMac.hxx"
 #include "MWAWPictBitmap.hxx"
@@ -341,28 +342,12 @@ struct Bitmap {
   //! creates the bitmap from the packdata
   bool unpackedData(unsigned char const *pData, int sz)
   {
-    int rPos = 0;
-    size_t wPos = m_bitmap.size(), wNPos = wPos+size_t(m_rowBytes);
-    m_bitmap.resize(size_t(wNPos));
-
-    while (rPos < sz) {
-      if (rPos+2 > sz) return false;
-      auto n = static_cast<signed char>(pData[rPos++]);
-      if (n < 0) {
-        int nCount = 1-n;
-        if (wPos+size_t(nCount) > wNPos) return false;
-
-        unsigned char val = pData[rPos++];
-        for (int i = 0; i < nCount; i++)
-          m_bitmap[wPos++] = val;
-        continue;
-      }
-      int nCount = 1+n;
-      if (rPos+nCount > sz || wPos+size_t(nCount) > wNPos) return false;
-      for (int i = 0; i < nCount; i++)
-        m_bitmap[wPos++] = pData[rPos++];
-    }
-    return (wPos == wNPos);
+    size_t wPos = m_bitmap.size();
+    m_bitmap.resize(wPos+size_t(m_rowBytes));
+    unsigned char const *pEnd=pData+sz;
+    size_t numWritten;
+    return libmwaw::PackBits::unpack(pData, pEnd, m_bitmap.data()+wPos, size_t(m_rowBytes), numWritten) &&
+           pData==pEnd && numWritten==size_t(m_rowBytes);
   }
 
   //! parses the bitmap data zone
@@ -935,10 +920,9 @@ protected:
   //! low level: reads a polygon argument
   static bool readPoly(MWAWInputStream &input, DataType type, MWAWBox2i &box, std::vector<MWAWVec2i> &res)
   {
-    DataType boxType, valType;
+    DataType boxType;
     switch (type) {
     case WP_POLY:
-      valType = WP_POINT;
       boxType = WP_RECT;
       break;
     case WP_NONE:
@@ -987,11 +971,14 @@ protected:
     numPt /= 2;
     res.resize(size_t(numPt));
 
-    MWAWVec2i pt;
-    for (auto &p : res) {
-      if (!readPoint(input, valType, pt)) return false;
-      p = pt;
+    // the points are stored as pairs of int16
+    std::vector<int16_t> coords(2*size_t(numPt));
+    if (!input.readS16Array(coords.data(), coords.size())) {
+      MWAW_DEBUG_MSG(("Pict1:OpCode: readPoly find end of file...\n"));
+      return false;
     }
+    for (size_t i = 0; i < res.size(); ++i)
+      res[i].set(coords[2*i], coords[2*i+1]);
     return true;
   }
   //! low level: reads a string argument
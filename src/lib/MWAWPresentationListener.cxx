@@ -51,10 +51,12 @@
 #include "MWAWList.hxx"
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
+#include "MWAWPictBitmap.hxx"
 #include "MWAWPosition.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
+#include "MWAWTextBuffer.hxx"
 
 #include "MWAWPresentationListener.hxx"
 
@@ -122,8 +124,8 @@ struct State {
   }
   //! the origin position
   MWAWVec2f m_origin;
-  //! a buffer to stored the text
-  librevenge::RVNGString m_textBuffer;
+  //! the text buffer
+  MWAWTextBuffer m_textBuffer;
 
   //! the font
   MWAWFont m_font;
@@ -174,7 +176,7 @@ private:
 
 State::State()
   : m_origin(0,0)
-  , m_textBuffer("")
+  , m_textBuffer()
   , m_font(20,12)/* default time 12 */
   , m_paragraph()
   , m_list()
@@ -241,16 +243,9 @@ void MWAWPresentationListener::insertCharacter(unsigned char c)
     MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacter: called outside a text zone\n"));
     return;
   }
-  int unicode = m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), c);
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWPresentationListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWPresentationListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, unicode))
+    MWAWPresentationListener::insertUnicode(unicode);
 }
 
 int MWAWPresentationListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos)
@@ -263,30 +258,29 @@ int MWAWPresentationListener::insertCharacter(unsigned char c, MWAWInputStreamPt
     MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacter: input or font converter does not exist!!!!\n"));
     return 0;
   }
-  long debPos=input->tell();
-  int fId = m_ps->m_font.id();
-  int unicode = endPos==debPos ?
-                m_parserState.m_fontConverter->unicode(fId, c) :
-                m_parserState.m_fontConverter->unicode(fId, c, input);
-
-  long pos=input->tell();
-  if (endPos > 0 && pos > endPos) {
-    MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacter: problem reading a character\n"));
-    pos = debPos;
-    input->seek(pos, librevenge::RVNG_SEEK_SET);
-    unicode = m_parserState.m_fontConverter->unicode(fId, c);
-  }
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWPresentationListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWPresentationListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  int numRead;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, input, endPos, unicode, numRead))
+    MWAWPresentationListener::insertUnicode(unicode);
+  return numRead;
+}
 
-  return int(pos-debPos);
+void MWAWPresentationListener::insertCharacters(uint8_t const *data, size_t len)
+{
+  if (!m_ps->isInTextZone()) {
+    MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacters: called outside a text zone\n"));
+    return;
+  }
+  if (!data || !len) return;
+  if (!m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWPresentationListener::insertCharacters: the font converter does not exist!!!!\n"));
+    return;
+  }
+  std::string utf8;
+  m_parserState.m_fontConverter->convert(m_ps->m_font.id(), data, len, utf8);
+  if (utf8.empty()) return;
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(utf8);
 }
 
 void MWAWPresentationListener::insertUnicode(uint32_t val)
@@ -299,7 +293,7 @@ void MWAWPresentationListener::insertUnicode(uint32_t val)
   if (val == 0xfffd) return;
 
   if (!m_ps->m_isSpanOpened) _openSpan();
-  libmwaw::appendUnicode(val, m_ps->m_textBuffer);
+  m_ps->m_textBuffer.appendUnicode(val);
 }
 
 void MWAWPresentationListener::insertUnicodeString(librevenge::RVNGString const &str)
@@ -724,18 +718,7 @@ void MWAWPresentationListener::_closeListElement()
 
 int MWAWPresentationListener::_getListId() const
 {
-  auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
-  if (newLevel == 0) return -1;
-  int newListId = m_ps->m_paragraph.m_listId.get();
-  if (newListId > 0) return newListId;
-  static bool first = true;
-  if (first) {
-    MWAW_DEBUG_MSG(("MWAWPresentationListener::_getListId: the list id is not set, try to find a new one\n"));
-    first = false;
-  }
-  auto list=m_parserState.m_listManager->getNewList(m_ps->m_list, int(newLevel), *m_ps->m_paragraph.m_listLevel);
-  if (!list) return -1;
-  return list->getId();
+  return m_parserState.m_listManager->getListId(m_ps->m_paragraph, m_ps->m_list);
 }
 
 void MWAWPresentationListener::_changeList()
@@ -747,52 +730,15 @@ void MWAWPresentationListener::_changeList()
   if (m_ps->m_isParagraphOpened)
     _closeParagraph();
 
-  size_t actualLevel = m_ps->m_listOrderedLevels.size();
   auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
   if (newLevel>100) {
     MWAW_DEBUG_MSG(("MWAWPresentationListener::_changeList: find level=%d, set it to 100\n", static_cast<int>(newLevel)));
     newLevel=100;
   }
   int newListId = newLevel>0 ? _getListId() : -1;
-  bool changeList = newLevel &&
-                    (m_ps->m_list && m_ps->m_list->getId()!=newListId);
-  size_t minLevel = changeList ? 0 : newLevel;
-  while (actualLevel > minLevel) {
-    if (m_ps->m_listOrderedLevels[--actualLevel])
-      m_documentInterface->closeOrderedListLevel();
-    else
-      m_documentInterface->closeUnorderedListLevel();
-  }
-
-  if (newLevel) {
-    std::shared_ptr<MWAWList> theList;
-
-    theList=m_parserState.m_listManager->getList(newListId);
-    if (!theList) {
-      MWAW_DEBUG_MSG(("MWAWPresentationListener::_changeList: can not find any list\n"));
-      m_ps->m_listOrderedLevels.resize(actualLevel);
-      return;
-    }
-    m_parserState.m_listManager->needToSend(newListId, m_ds->m_sentListMarkers);
-    m_ps->m_list = theList;
-    m_ps->m_list->setLevel(static_cast<int>(newLevel));
-  }
-
-  m_ps->m_listOrderedLevels.resize(newLevel, false);
-  if (actualLevel == newLevel) return;
-
-  librevenge::RVNGPropertyList propList;
-  propList.insert("librevenge:list-id", m_ps->m_list->getId());
-  for (size_t i=actualLevel+1; i<= newLevel; i++) {
-    bool ordered = m_ps->m_list->isNumeric(int(i));
-    m_ps->m_listOrderedLevels[i-1] = ordered;
-
-    librevenge::RVNGPropertyList level;
-    m_ps->m_list->addTo(int(i), level, m_parserState.m_fontManager);
-    if (ordered)
-      m_documentInterface->openOrderedListLevel(level);
-    else
-      m_documentInterface->openUnorderedListLevel(level);
+  if (!m_parserState.m_listManager->changeLevels(*m_documentInterface, newListId, newLevel, m_ps->m_listOrderedLevels,
+      m_ps->m_list, m_ds->m_sentListMarkers)) {
+    MWAW_DEBUG_MSG(("MWAWPresentationListener::_changeList: can not find any list\n"));
   }
 }
 
@@ -849,30 +795,9 @@ void MWAWPresentationListener::_closeSpan()
 ///////////////////
 void MWAWPresentationListener::_flushText()
 {
-  if (m_ps->m_textBuffer.len() == 0) return;
-
-  // when some many ' ' follows each other, call insertSpace
-  librevenge::RVNGString tmpText("");
-  int numConsecutiveSpaces = 0;
-  librevenge::RVNGString::Iter i(m_ps->m_textBuffer);
-  for (i.rewind(); i.next();) {
-    if (*(i()) == 0x20) // this test is compatible with unicode format
-      numConsecutiveSpaces++;
-    else
-      numConsecutiveSpaces = 0;
+  if (m_ps->m_textBuffer.empty()) return;
 
-    if (numConsecutiveSpaces > 1) {
-      if (tmpText.len() > 0) {
-        m_documentInterface->insertText(tmpText);
-        tmpText.clear();
-      }
-      m_documentInterface->insertSpace();
-    }
-    else
-      tmpText.append(i());
-  }
-  m_documentInterface->insertText(tmpText);
-  m_ps->m_textBuffer.clear();
+  m_ps->m_textBuffer.flush(*m_documentInterface);
 }
 
 ///////////////////
@@ -1085,7 +1010,10 @@ void MWAWPresentationListener::insertPicture(MWAWPosition const &pos, MWAWEmbedd
     list.insert("librevenge:rotate-cx",double(center[0]), librevenge::RVNG_POINT);
     list.insert("librevenge:rotate-cy",double(center[1]), librevenge::RVNG_POINT);
   }
-  if (picture.addTo(list))
+  MWAWEmbeddedObject object(picture);
+  if (!m_parserState.m_rawBitmaps)
+    MWAWPictBitmap::encodeRawData(object, m_parserState.m_parseOptions);
+  if (object.addTo(list))
     m_documentInterface->drawGraphicObject(list);
 }
 
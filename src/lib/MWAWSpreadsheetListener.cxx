@@ -60,10 +60,12 @@
 #include "MWAWPageSpan.hxx"
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
+#include "MWAWPictBitmap.hxx"
 #include "MWAWPosition.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
+#include "MWAWTextBuffer.hxx"
 
 #include "MWAWSpreadsheetListener.hxx"
 
@@ -82,6 +84,7 @@ struct DocumentState {
     , m_footNoteNumber(0)
     , m_smallPictureNumber(0)
     , m_isDocumentStarted(false)
+    , m_isEmbedded(false)
     , m_isSheetOpened(false)
     , m_isSheetRowOpened(false)
     , m_sentListMarkers()
@@ -106,6 +109,7 @@ struct DocumentState {
 
   int m_smallPictureNumber /** number of small picture */;
   bool m_isDocumentStarted /** a flag to know if the document is open */;
+  bool m_isEmbedded /** a flag to know if the listener creates an embedded spreadsheet */;
   bool m_isSheetOpened /** a flag to know if a sheet is open */;
   bool m_isSheetRowOpened /** a flag to know if a row is open */;
   /// the list of marker corresponding to sent list
@@ -133,10 +137,8 @@ struct State {
     return m_isTextboxOpened || m_isTableCellOpened || m_isNote;
   }
 
-  //! a buffer to stored the text
-  librevenge::RVNGString m_textBuffer;
-  //! the number of tabs to add
-  int m_numDeferredTabs;
+  //! the text buffer
+  MWAWTextBuffer m_textBuffer;
 
   //! the font
   MWAWFont m_font;
@@ -186,8 +188,7 @@ private:
 };
 
 State::State()
-  : m_textBuffer("")
-  , m_numDeferredTabs(0)
+  : m_textBuffer()
 
   , m_font(20,12) // default time 12
 
@@ -253,6 +254,7 @@ MWAWSpreadsheetListener::MWAWSpreadsheetListener(MWAWParserState &parserState, M
   pageSpan.setFormWidth(double(box.size().x())/72.);
   pageSpan.setFormLength(double(box.size().y())/72.);
   m_ds.reset(new MWAWSpreadsheetListenerInternal::DocumentState(std::vector<MWAWPageSpan>(1, pageSpan)));
+  m_ds->m_isEmbedded=true;
 }
 
 
@@ -289,16 +291,9 @@ void MWAWSpreadsheetListener::insertCharacter(unsigned char c)
     MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacter: called outside a text zone\n"));
     return;
   }
-  int unicode = m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), c);
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWSpreadsheetListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWSpreadsheetListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, unicode))
+    MWAWSpreadsheetListener::insertUnicode(unicode);
 }
 
 int MWAWSpreadsheetListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos)
@@ -311,30 +306,30 @@ int MWAWSpreadsheetListener::insertCharacter(unsigned char c, MWAWInputStreamPtr
     MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacter: input or font converter does not exist!!!!\n"));
     return 0;
   }
-  long debPos=input->tell();
-  int fId = m_ps->m_font.id();
-  int unicode = endPos==debPos ?
-                m_parserState.m_fontConverter->unicode(fId, c) :
-                m_parserState.m_fontConverter->unicode(fId, c, input);
-
-  long pos=input->tell();
-  if (endPos > 0 && pos > endPos) {
-    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacter: problem reading a character\n"));
-    pos = debPos;
-    input->seek(pos, librevenge::RVNG_SEEK_SET);
-    unicode = m_parserState.m_fontConverter->unicode(fId, c);
-  }
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWSpreadsheetListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWSpreadsheetListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  int numRead;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, input, endPos, unicode, numRead))
+    MWAWSpreadsheetListener::insertUnicode(unicode);
+  return numRead;
+}
 
-  return int(pos-debPos);
+void MWAWSpreadsheetListener::insertCharacters(uint8_t const *data, size_t len)
+{
+  if (!m_ps->canWriteText()) {
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacters: called outside a text zone\n"));
+    return;
+  }
+  if (!data || !len) return;
+  if (!m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::insertCharacters: the font converter does not exist!!!!\n"));
+    return;
+  }
+  std::string utf8;
+  m_parserState.m_fontConverter->convert(m_ps->m_font.id(), data, len, utf8);
+  if (utf8.empty()) return;
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(utf8);
 }
 
 void MWAWSpreadsheetListener::insertUnicode(uint32_t val)
@@ -349,7 +344,7 @@ void MWAWSpreadsheetListener::insertUnicode(uint32_t val)
 
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
-  libmwaw::appendUnicode(val, m_ps->m_textBuffer);
+  m_ps->m_textBuffer.appendUnicode(val);
 }
 
 void MWAWSpreadsheetListener::insertUnicodeString(librevenge::RVNGString const &str)
@@ -395,11 +390,11 @@ void MWAWSpreadsheetListener::insertTab()
   }
 
   if (!m_ps->m_isParagraphOpened) {
-    m_ps->m_numDeferredTabs++;
+    m_ps->m_textBuffer.addDeferredTab();
     return;
   }
   if (m_ps->m_isSpanOpened) _flushText();
-  m_ps->m_numDeferredTabs++;
+  m_ps->m_textBuffer.addDeferredTab();
   _flushDeferredTabs();
 }
 
@@ -787,18 +782,7 @@ void MWAWSpreadsheetListener::_closeListElement()
 
 int MWAWSpreadsheetListener::_getListId() const
 {
-  auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
-  if (newLevel == 0) return -1;
-  int newListId = m_ps->m_paragraph.m_listId.get();
-  if (newListId > 0) return newListId;
-  static bool first = true;
-  if (first) {
-    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::_getListId: the list id is not set, try to find a new one\n"));
-    first = false;
-  }
-  auto list=m_parserState.m_listManager->getNewList(m_ps->m_list, int(newLevel), *m_ps->m_paragraph.m_listLevel);
-  if (!list) return -1;
-  return list->getId();
+  return m_parserState.m_listManager->getListId(m_ps->m_paragraph, m_ps->m_list);
 }
 
 void MWAWSpreadsheetListener::_changeList()
@@ -809,50 +793,15 @@ void MWAWSpreadsheetListener::_changeList()
   if (m_ps->m_isParagraphOpened)
     _closeParagraph();
 
-  size_t actualLevel = m_ps->m_listOrderedLevels.size();
   auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
   if (newLevel>100) {
     MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::_changeList: find level=%d, set it to 100\n", static_cast<int>(newLevel)));
     newLevel=100;
   }
   int newListId = newLevel>0 ? _getListId() : -1;
-  bool changeList = newLevel &&
-                    (m_ps->m_list && m_ps->m_list->getId()!=newListId);
-  size_t minLevel = changeList ? 0 : newLevel;
-  while (actualLevel > minLevel) {
-    if (m_ps->m_listOrderedLevels[--actualLevel])
-      m_documentInterface->closeOrderedListLevel();
-    else
-      m_documentInterface->closeUnorderedListLevel();
-  }
-
-  if (newLevel) {
-    std::shared_ptr<MWAWList> theList;
-
-    theList=m_parserState.m_listManager->getList(newListId);
-    if (!theList) {
-      MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::_changeList: can not find any list\n"));
-      m_ps->m_listOrderedLevels.resize(actualLevel);
-      return;
-    }
-    m_parserState.m_listManager->needToSend(newListId, m_ds->m_sentListMarkers);
-    m_ps->m_list = theList;
-    m_ps->m_list->setLevel(static_cast<int>(newLevel));
-  }
-
-  m_ps->m_listOrderedLevels.resize(newLevel, false);
-  if (actualLevel == newLevel) return;
-
-  for (size_t i=actualLevel+1; i<= newLevel; i++) {
-    bool ordered = m_ps->m_list->isNumeric(int(i));
-    m_ps->m_listOrderedLevels[i-1] = ordered;
-
-    librevenge::RVNGPropertyList level;
-    m_ps->m_list->addTo(int(i), level, m_parserState.m_fontManager);
-    if (ordered)
-      m_documentInterface->openOrderedListLevel(level);
-    else
-      m_documentInterface->openUnorderedListLevel(level);
+  if (!m_parserState.m_listManager->changeLevels(*m_documentInterface, newListId, newLevel, m_ps->m_listOrderedLevels,
+      m_ps->m_list, m_ds->m_sentListMarkers)) {
+    MWAW_DEBUG_MSG(("MWAWSpreadsheetListener::_changeList: can not find any list\n"));
   }
 }
 
@@ -896,12 +845,11 @@ void MWAWSpreadsheetListener::_closeSpan()
 ///////////////////
 void MWAWSpreadsheetListener::_flushDeferredTabs()
 {
-  if (m_ps->m_numDeferredTabs == 0 || !m_ps->canWriteText())
+  if (m_ps->m_textBuffer.numDeferredTabs() == 0 || !m_ps->canWriteText())
     return;
   if (!m_ps->m_font.hasDecorationLines()) {
     if (!m_ps->m_isSpanOpened) _openSpan();
-    for (; m_ps->m_numDeferredTabs > 0; m_ps->m_numDeferredTabs--)
-      m_documentInterface->insertTab();
+    m_ps->m_textBuffer.flushDeferredTabs(*m_documentInterface);
     return;
   }
 
@@ -909,37 +857,15 @@ void MWAWSpreadsheetListener::_flushDeferredTabs()
   m_ps->m_font.resetDecorationLines();
   _closeSpan();
   _openSpan();
-  for (; m_ps->m_numDeferredTabs > 0; m_ps->m_numDeferredTabs--)
-    m_documentInterface->insertTab();
+  m_ps->m_textBuffer.flushDeferredTabs(*m_documentInterface);
   setFont(oldFont);
 }
 
 void MWAWSpreadsheetListener::_flushText()
 {
-  if (m_ps->m_textBuffer.len() == 0  || !m_ps->canWriteText()) return;
-
-  // when some many ' ' follows each other, call insertSpace
-  librevenge::RVNGString tmpText;
-  int numConsecutiveSpaces = 0;
-  librevenge::RVNGString::Iter i(m_ps->m_textBuffer);
-  for (i.rewind(); i.next();) {
-    if (*(i()) == 0x20) // this test is compatible with unicode format
-      numConsecutiveSpaces++;
-    else
-      numConsecutiveSpaces = 0;
+  if (m_ps->m_textBuffer.empty() || !m_ps->canWriteText()) return;
 
-    if (numConsecutiveSpaces > 1) {
-      if (tmpText.len() > 0) {
-        m_documentInterface->insertText(tmpText);
-        tmpText.clear();
-      }
-      m_documentInterface->insertSpace();
-    }
-    else
-      tmpText.append(i());
-  }
-  m_documentInterface->insertText(tmpText);
-  m_ps->m_textBuffer.clear();
+  m_ps->m_textBuffer.flush(*m_documentInterface);
 }
 
 ///////////////////
@@ -1153,8 +1079,12 @@ void MWAWSpreadsheetListener::insertPicture(MWAWPosition const &pos, MWAWEmbedde
   }
   if (!openFrame(pos, style)) return;
 
+  MWAWEmbeddedObject object(picture);
+  // the bitmaps of an embedded spreadsheet are always encoded
+  if (!m_parserState.m_rawBitmaps || m_ds->m_isEmbedded)
+    MWAWPictBitmap::encodeRawData(object, m_parserState.m_parseOptions);
   librevenge::RVNGPropertyList propList;
-  if (picture.addTo(propList))
+  if (object.addTo(propList))
     m_documentInterface->insertBinaryObject(propList);
 
   closeFrame();
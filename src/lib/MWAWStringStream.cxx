@@ -20,6 +20,7 @@
 */
 
 #include <cstring>
+#include <utility>
 #include <vector>
 
 #include <librevenge-stream/librevenge-stream.h>
@@ -32,6 +33,8 @@ class MWAWStringStreamPrivate
 public:
   //! constructor
   MWAWStringStreamPrivate(const unsigned char *data, unsigned dataSize);
+  //! constructor which takes the ownership of the data
+  explicit MWAWStringStreamPrivate(std::vector<unsigned char> &&data);
   //! destructor
   ~MWAWStringStreamPrivate();
   //! append some data at the end of the actual stream
@@ -57,6 +60,12 @@ MWAWStringStreamPrivate::MWAWStringStreamPrivate(const unsigned char *data, unsi
   }
 }
 
+MWAWStringStreamPrivate::MWAWStringStreamPrivate(std::vector<unsigned char> &&data)
+  : m_buffer(std::move(data))
+  , m_offset(0)
+{
+}
+
 MWAWStringStreamPrivate::~MWAWStringStreamPrivate()
 {
 }
@@ -80,6 +89,12 @@ MWAWStringStream::MWAWStringStream(const unsigned char *data, const unsigned int
 {
 }
 
+MWAWStringStream::MWAWStringStream(std::vector<unsigned char> &&data)
+  : librevenge::RVNGInputStream()
+  , m_data(new MWAWStringStreamPrivate(std::move(data)))
+{
+}
+
 MWAWStringStream::~MWAWStringStream()
 {
 }
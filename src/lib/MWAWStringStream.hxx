@@ -23,6 +23,7 @@
 #define MWAW_STRING_STREAM_HXX
 
 #include <memory>
+#include <vector>
 
 #include <librevenge-stream/librevenge-stream.h>
 
@@ -38,6 +39,8 @@ class MWAWStringStream final : public librevenge::RVNGInputStream
 public:
   //! constructor
   MWAWStringStream(const unsigned char *data, const unsigned int dataSize);
+  //! constructor which takes the ownership of the data, ie. no data are copied
+  explicit MWAWStringStream(std::vector<unsigned char> &&data);
   //! destructor
   ~MWAWStringStream() final;
 
@@ -0,0 +1,88 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#include <cstring>
+
+#include "libmwaw_internal.hxx"
+
+#include "MWAWFontConverter.hxx"
+#include "MWAWInputStream.hxx"
+
+#include "MWAWTextBuffer.hxx"
+
+bool MWAWTextBuffer::getUnicode(MWAWFontConverter const &converter, int fId, unsigned char c, uint32_t &unicode)
+{
+  int res=converter.unicode(fId, c);
+  if (res!=-1) {
+    unicode=uint32_t(res);
+    return true;
+  }
+  if (c < 0x20) {
+    MWAW_DEBUG_MSG(("MWAWTextBuffer::getUnicode: find odd char %x\n", static_cast<unsigned int>(c)));
+    return false;
+  }
+  unicode=c;
+  return true;
+}
+
+bool MWAWTextBuffer::getUnicode(MWAWFontConverter const &converter, int fId, unsigned char c,
+                                MWAWInputStreamPtr &input, long endPos, uint32_t &unicode, int &numRead)
+{
+  long debPos=input->tell();
+  int res = endPos==debPos ? converter.unicode(fId, c) : converter.unicode(fId, c, input);
+
+  long pos=input->tell();
+  if (endPos > 0 && pos > endPos) {
+    MWAW_DEBUG_MSG(("MWAWTextBuffer::getUnicode: problem reading a character\n"));
+    pos = debPos;
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
+    res = converter.unicode(fId, c);
+  }
+  numRead=int(pos-debPos);
+  if (res!=-1) {
+    unicode=uint32_t(res);
+    return true;
+  }
+  if (c < 0x20) {
+    MWAW_DEBUG_MSG(("MWAWTextBuffer::getUnicode: find odd char %x\n", static_cast<unsigned int>(c)));
+    return false;
+  }
+  unicode=c;
+  return true;
+}
+
+size_t MWAWTextBuffer::findDoubleSpace(size_t pos) const
+{
+  // look for a space with memchr (which is usually vectorized), then check the following character
+  char const *begin=m_text.c_str();
+  char const *end=begin+m_text.size();
+  char const *ptr=begin+pos;
+  while (ptr+1<end) {
+    auto space=static_cast<char const *>(std::memchr(ptr, ' ', size_t(end-1-ptr)));
+    if (!space) break;
+    if (space[1]==' ')
+      return size_t(space-begin);
+    ptr=space+2;
+  }
+  return std::string::npos;
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,161 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#ifndef MWAW_TEXT_BUFFER_HXX
+#define MWAW_TEXT_BUFFER_HXX
+
+#include <string>
+
+#include <librevenge/librevenge.h>
+
+#include "libmwaw_internal.hxx"
+
+/** internal class shared by the listeners to convert the characters and
+    to store the UTF-8 text and the deferred tabs of the current span
+    before sending them to the document interface.
+
+    \note the memory is kept when the buffer is cleared, so the same
+    buffer can be reused for all the spans of a document.
+ */
+class MWAWTextBuffer
+{
+public:
+  //! constructor
+  MWAWTextBuffer()
+    : m_text()
+    , m_slice()
+    , m_numDeferredTabs(0)
+  {
+  }
+  /** converts the character c of the font fId in unicode.
+
+      \return false if the character must be ignored, ie. if it is a
+      control character which can not be converted
+   */
+  static bool getUnicode(MWAWFontConverter const &converter, int fId, unsigned char c, uint32_t &unicode);
+  /** converts the character c of the font fId in unicode, if needed
+      reads the next character in input (if endPos is not reached).
+
+      \return false if the character must be ignored, numRead is set
+      to the number of characters read in input
+   */
+  static bool getUnicode(MWAWFontConverter const &converter, int fId, unsigned char c,
+                         MWAWInputStreamPtr &input, long endPos, uint32_t &unicode, int &numRead);
+
+  //! returns true if the buffer is empty
+  bool empty() const
+  {
+    return m_text.empty();
+  }
+  //! returns the number of bytes stored in the buffer
+  size_t size() const
+  {
+    return m_text.size();
+  }
+  //! returns the stored text
+  std::string const &str() const
+  {
+    return m_text;
+  }
+  //! clears the buffer (but keeps its memory)
+  void clear()
+  {
+    m_text.clear();
+  }
+  //! appends a character
+  void append(char c)
+  {
+    m_text+=c;
+  }
+  //! appends an UTF-8 string
+  void append(std::string const &str)
+  {
+    m_text.append(str);
+  }
+  //! appends an UTF-8 string
+  void append(librevenge::RVNGString const &str)
+  {
+    m_text.append(str.cstr(), size_t(str.size()));
+  }
+  //! appends an unicode character
+  void appendUnicode(uint32_t val)
+  {
+    if (val<0x80) {
+      m_text+=char(val);
+      return;
+    }
+    char buffer[7];
+    m_text.append(buffer, size_t(libmwaw::getUTF8(val, buffer)));
+  }
+  //! returns the number of deferred tabs
+  int numDeferredTabs() const
+  {
+    return m_numDeferredTabs;
+  }
+  //! adds a deferred tab
+  void addDeferredTab()
+  {
+    ++m_numDeferredTabs;
+  }
+  //! sends the deferred tabs to the interface
+  template <class Interface>
+  void flushDeferredTabs(Interface &interface)
+  {
+    for (; m_numDeferredTabs>0; --m_numDeferredTabs)
+      interface.insertTab();
+  }
+
+  /** sends the text to the interface and clears the buffer.
+
+      When some spaces follow each other, the first one is sent with
+      the text and the following ones with insertSpace.
+   */
+  template <class Interface>
+  void flush(Interface &interface)
+  {
+    if (m_text.empty()) return;
+    size_t begin=0, pos=0;
+    while ((pos=findDoubleSpace(pos))!=std::string::npos) {
+      ++pos;
+      m_slice.assign(m_text, begin, pos-begin);
+      interface.insertText(librevenge::RVNGString(m_slice.c_str()));
+      for (; pos<m_text.size() && m_text[pos]==' '; ++pos)
+        interface.insertSpace();
+      begin=pos;
+    }
+    interface.insertText(librevenge::RVNGString(m_text.c_str()+begin));
+    m_text.clear();
+  }
+
+protected:
+  //! returns the position of the next two consecutive spaces or std::string::npos
+  size_t findDoubleSpace(size_t pos) const;
+
+  //! the UTF-8 text
+  std::string m_text;
+  //! a string used by flush to store a part of the text
+  std::string m_slice;
+  //! the number of tabs to add
+  int m_numDeferredTabs;
+};
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
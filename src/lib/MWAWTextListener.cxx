@@ -40,6 +40,8 @@
 
 #include <cstring>
 #include <iomanip>
+#include <map>
+#include <set>
 #include <sstream>
 #include <time.h>
 
@@ -59,10 +61,12 @@
 #include "MWAWPageSpan.hxx"
 #include "MWAWParagraph.hxx"
 #include "MWAWParser.hxx"
+#include "MWAWPictBitmap.hxx"
 #include "MWAWPosition.hxx"
 #include "MWAWSection.hxx"
 #include "MWAWSubDocument.hxx"
 #include "MWAWTable.hxx"
+#include "MWAWTextBuffer.hxx"
 
 #include "MWAWTextListener.hxx"
 
@@ -71,6 +75,16 @@ namespace MWAWTextListenerInternal
 {
 //! a enum to define basic break bit
 enum { PageBreakBit=0x1, ColumnBreakBit=0x2 };
+/*! \struct ParagraphCompare
+ * \brief internal struct used to create sorted map of paragraph
+ */
+struct ParagraphCompare {
+  //! comparaison function
+  bool operator()(MWAWParagraph const &p1, MWAWParagraph const &p2) const
+  {
+    return p1.cmp(p2) < 0;
+  }
+};
 //! a class to store the document state of a MWAWTextListener
 struct DocumentState {
   //! constructor
@@ -81,10 +95,13 @@ struct DocumentState {
     , m_footNoteNumber(0)
     , m_endNoteNumber(0)
     , m_smallPictureNumber(0)
+    , m_numSentPages(0)
     , m_isDocumentStarted(false)
     , m_isHeaderFooterStarted(false)
     , m_sentListMarkers()
     , m_subDocuments()
+    , m_definedSpanIdSet()
+    , m_paragraphStyleMap()
   {
   }
   //! destructor
@@ -102,10 +119,16 @@ struct DocumentState {
   int m_footNoteNumber /** footnote number*/, m_endNoteNumber /** endnote number*/;
 
   int m_smallPictureNumber /** number of small picture */;
+  //! the number of pages which have been ended by a page break
+  int m_numSentPages;
   bool m_isDocumentStarted /** a flag to know if the document is open */, m_isHeaderFooterStarted /** a flag to know if the header footer is started */;
   /// the list of marker corresponding to sent list
   std::vector<int> m_sentListMarkers;
   std::vector<MWAWSubDocumentPtr> m_subDocuments; /** list of document actually open */
+  //! the span style ids (given by MWAWFontManager::getId) already defined
+  std::set<int> m_definedSpanIdSet;
+  //! the maps paragraph to paragraph style id (already defined): outside/inside a table
+  std::map<MWAWParagraph, int, ParagraphCompare> m_paragraphStyleMap[2];
 
 private:
   DocumentState(const DocumentState &) = delete;
@@ -119,10 +142,8 @@ struct State {
   //! destructor
   ~State() { }
 
-  //! a buffer to stored the text
-  librevenge::RVNGString m_textBuffer;
-  //! the number of tabs to add
-  int m_numDeferredTabs;
+  //! the text buffer
+  MWAWTextBuffer m_textBuffer;
 
   //! the font
   MWAWFont m_font;
@@ -174,8 +195,7 @@ private:
 };
 
 State::State()
-  : m_textBuffer("")
-  , m_numDeferredTabs(0)
+  : m_textBuffer()
 
   , m_font(20,12) // default time 12
 
@@ -248,16 +268,9 @@ void MWAWTextListener::insertChar(uint8_t character)
 
 void MWAWTextListener::insertCharacter(unsigned char c)
 {
-  int unicode = m_parserState.m_fontConverter->unicode(m_ps->m_font.id(), c);
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWTextListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWTextListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWTextListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, unicode))
+    MWAWTextListener::insertUnicode(unicode);
 }
 
 int MWAWTextListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos)
@@ -266,30 +279,26 @@ int MWAWTextListener::insertCharacter(unsigned char c, MWAWInputStreamPtr &input
     MWAW_DEBUG_MSG(("MWAWTextListener::insertCharacter: input or font converter does not exist!!!!\n"));
     return 0;
   }
-  long debPos=input->tell();
-  int fId = m_ps->m_font.id();
-  int unicode = endPos==debPos ?
-                m_parserState.m_fontConverter->unicode(fId, c) :
-                m_parserState.m_fontConverter->unicode(fId, c, input);
-
-  long pos=input->tell();
-  if (endPos > 0 && pos > endPos) {
-    MWAW_DEBUG_MSG(("MWAWTextListener::insertCharacter: problem reading a character\n"));
-    pos = debPos;
-    input->seek(pos, librevenge::RVNG_SEEK_SET);
-    unicode = m_parserState.m_fontConverter->unicode(fId, c);
-  }
-  if (unicode == -1) {
-    if (c < 0x20) {
-      MWAW_DEBUG_MSG(("MWAWTextListener::insertCharacter: Find odd char %x\n", static_cast<unsigned int>(c)));
-    }
-    else
-      MWAWTextListener::insertChar(static_cast<uint8_t>(c));
-  }
-  else
-    MWAWTextListener::insertUnicode(static_cast<uint32_t>(unicode));
+  uint32_t unicode;
+  int numRead;
+  if (MWAWTextBuffer::getUnicode(*m_parserState.m_fontConverter, m_ps->m_font.id(), c, input, endPos, unicode, numRead))
+    MWAWTextListener::insertUnicode(unicode);
+  return numRead;
+}
 
-  return int(pos-debPos);
+void MWAWTextListener::insertCharacters(uint8_t const *data, size_t len)
+{
+  if (!data || !len) return;
+  if (!m_parserState.m_fontConverter) {
+    MWAW_DEBUG_MSG(("MWAWTextListener::insertCharacters: the font converter does not exist!!!!\n"));
+    return;
+  }
+  std::string utf8;
+  m_parserState.m_fontConverter->convert(m_ps->m_font.id(), data, len, utf8);
+  if (utf8.empty()) return;
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(utf8);
 }
 
 void MWAWTextListener::insertUnicode(uint32_t val)
@@ -299,7 +308,7 @@ void MWAWTextListener::insertUnicode(uint32_t val)
 
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
-  libmwaw::appendUnicode(val, m_ps->m_textBuffer);
+  m_ps->m_textBuffer.appendUnicode(val);
 }
 
 void MWAWTextListener::insertUnicodeString(librevenge::RVNGString const &str)
@@ -330,16 +339,22 @@ void MWAWTextListener::insertEOL(bool soft)
 void MWAWTextListener::insertTab()
 {
   if (!m_ps->m_isParagraphOpened) {
-    m_ps->m_numDeferredTabs++;
+    m_ps->m_textBuffer.addDeferredTab();
     return;
   }
   if (m_ps->m_isSpanOpened) _flushText();
-  m_ps->m_numDeferredTabs++;
+  m_ps->m_textBuffer.addDeferredTab();
   _flushDeferredTabs();
 }
 
 void MWAWTextListener::insertBreak(MWAWTextListener::BreakType breakType)
 {
+  if ((breakType==PageBreak || breakType==SoftPageBreak) && !m_ps->m_inSubDocument &&
+      !m_parserState.isPageSent(++m_ds->m_numSentPages)) {
+    // the last requested page is sent, stop the parsing: endDocument will close the last page
+    m_parserState.m_maxPagesReached=true;
+    throw libmwaw::ParseException();
+  }
   switch (breakType) {
   case ColumnBreak:
     if (!m_ps->m_isPageSpanOpened && !m_ps->m_inSubDocument)
@@ -773,7 +788,15 @@ void MWAWTextListener::_openParagraph()
   }
 
   librevenge::RVNGPropertyList propList;
-  _appendParagraphProperties(propList);
+  // in text only mode, the paragraph properties are not sent
+  if (!m_parserState.m_textOnly) {
+    // the page number and the breaks are not part of the style
+    if (m_ps->m_paragraphNeedBreak ||
+        (!m_ps->m_inSubDocument && m_ps->m_firstParagraphInPageSpan && m_ds->m_pageSpan.getPageNumber() >= 0))
+      _appendParagraphProperties(propList);
+    else
+      propList.insert("librevenge:paragraph-id", _getParagraphStyleId());
+  }
   if (!m_ps->m_isParagraphOpened)
     m_documentInterface->openParagraph(propList);
 
@@ -813,6 +836,21 @@ void MWAWTextListener::_resetParagraphState(const bool isListElement)
   m_ps->m_isHeaderFooterWithoutParagraph = false;
 }
 
+int MWAWTextListener::_getParagraphStyleId()
+{
+  auto &styleMap=m_ds->m_paragraphStyleMap[m_ps->m_isTableOpened ? 1 : 0];
+  auto it=styleMap.find(m_ps->m_paragraph);
+  if (it!=styleMap.end())
+    return it->second;
+  int id=int(m_ds->m_paragraphStyleMap[0].size()+m_ds->m_paragraphStyleMap[1].size());
+  librevenge::RVNGPropertyList propList;
+  m_ps->m_paragraph.addTo(propList,m_ps->m_isTableOpened);
+  propList.insert("librevenge:paragraph-id", id);
+  m_documentInterface->defineParagraphStyle(propList);
+  styleMap[m_ps->m_paragraph]=id;
+  return id;
+}
+
 void MWAWTextListener::_appendParagraphProperties(librevenge::RVNGPropertyList &propList, const bool /*isListElement*/)
 {
   m_ps->m_paragraph.addTo(propList,m_ps->m_isTableOpened);
@@ -874,18 +912,7 @@ void MWAWTextListener::_closeListElement()
 
 int MWAWTextListener::_getListId() const
 {
-  auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get());
-  if (newLevel == 0) return -1;
-  int newListId = m_ps->m_paragraph.m_listId.get();
-  if (newListId > 0) return newListId;
-  static bool first = true;
-  if (first) {
-    MWAW_DEBUG_MSG(("MWAWTextListener::_getListId: the list id is not set, try to find a new one\n"));
-    first = false;
-  }
-  auto list=m_parserState.m_listManager->getNewList(m_ps->m_list, int(newLevel), *m_ps->m_paragraph.m_listLevel);
-  if (!list) return -1;
-  return list->getId();
+  return m_parserState.m_listManager->getListId(m_ps->m_paragraph, m_ps->m_list);
 }
 
 void MWAWTextListener::_changeList()
@@ -893,7 +920,6 @@ void MWAWTextListener::_changeList()
   if (m_ps->m_isParagraphOpened)
     _closeParagraph();
 
-  size_t actualLevel = m_ps->m_listOrderedLevels.size();
   auto newLevel= size_t(m_ps->m_paragraph.m_listLevelIndex.get() > 0 ? m_ps->m_paragraph.m_listLevelIndex.get() : 0);
   if (newLevel>100) {
     MWAW_DEBUG_MSG(("MWAWTextListener::_changeList: find level=%d, set it to 100\n", static_cast<int>(newLevel)));
@@ -904,43 +930,9 @@ void MWAWTextListener::_changeList()
     _openSection();
 
   int newListId = newLevel>0 ? _getListId() : -1;
-  bool changeList = newLevel &&
-                    (m_ps->m_list && m_ps->m_list->getId()!=newListId);
-  size_t minLevel = changeList ? 0 : newLevel;
-  while (actualLevel > minLevel) {
-    if (m_ps->m_listOrderedLevels[--actualLevel])
-      m_documentInterface->closeOrderedListLevel();
-    else
-      m_documentInterface->closeUnorderedListLevel();
-  }
-
-  if (newLevel) {
-    std::shared_ptr<MWAWList> theList;
-
-    theList=m_parserState.m_listManager->getList(newListId);
-    if (!theList) {
-      MWAW_DEBUG_MSG(("MWAWTextListener::_changeList: can not find any list\n"));
-      m_ps->m_listOrderedLevels.resize(actualLevel);
-      return;
-    }
-    m_parserState.m_listManager->needToSend(newListId, m_ds->m_sentListMarkers);
-    m_ps->m_list = theList;
-    m_ps->m_list->setLevel(static_cast<int>(newLevel));
-  }
-
-  m_ps->m_listOrderedLevels.resize(newLevel, false);
-  if (actualLevel == newLevel) return;
-
-  for (size_t i=actualLevel+1; i<= newLevel; i++) {
-    bool ordered = m_ps->m_list->isNumeric(int(i));
-    m_ps->m_listOrderedLevels[i-1] = ordered;
-
-    librevenge::RVNGPropertyList level;
-    m_ps->m_list->addTo(int(i), level, m_parserState.m_fontManager);
-    if (ordered)
-      m_documentInterface->openOrderedListLevel(level);
-    else
-      m_documentInterface->openUnorderedListLevel(level);
+  if (!m_parserState.m_listManager->changeLevels(*m_documentInterface, newListId, newLevel, m_ps->m_listOrderedLevels,
+      m_ps->m_list, m_ds->m_sentListMarkers)) {
+    MWAW_DEBUG_MSG(("MWAWTextListener::_changeList: can not find any list\n"));
   }
 }
 
@@ -964,13 +956,26 @@ void MWAWTextListener::_openSpan()
   }
 
   librevenge::RVNGPropertyList propList;
-  m_ps->m_font.addTo(propList, m_parserState.m_fontConverter);
+  if (!m_parserState.m_textOnly)
+    propList.insert("librevenge:span-id", _getSpanStyleId());
 
   m_documentInterface->openSpan(propList);
 
   m_ps->m_isSpanOpened = true;
 }
 
+int MWAWTextListener::_getSpanStyleId()
+{
+  int id=m_parserState.m_fontManager->getId(m_ps->m_font);
+  if (!m_ds->m_definedSpanIdSet.insert(id).second)
+    return id;
+  librevenge::RVNGPropertyList propList;
+  m_ps->m_font.addTo(propList, m_parserState.m_fontConverter);
+  propList.insert("librevenge:span-id", id);
+  m_documentInterface->defineCharacterStyle(propList);
+  return id;
+}
+
 void MWAWTextListener::_closeSpan()
 {
   // better not to close a link...
@@ -987,11 +992,10 @@ void MWAWTextListener::_closeSpan()
 ///////////////////
 void MWAWTextListener::_flushDeferredTabs()
 {
-  if (m_ps->m_numDeferredTabs == 0) return;
+  if (m_ps->m_textBuffer.numDeferredTabs() == 0) return;
   if (!m_ps->m_font.hasDecorationLines()) {
     if (!m_ps->m_isSpanOpened) _openSpan();
-    for (; m_ps->m_numDeferredTabs > 0; m_ps->m_numDeferredTabs--)
-      m_documentInterface->insertTab();
+    m_ps->m_textBuffer.flushDeferredTabs(*m_documentInterface);
     return;
   }
 
@@ -999,37 +1003,15 @@ void MWAWTextListener::_flushDeferredTabs()
   m_ps->m_font.resetDecorationLines();
   _closeSpan();
   _openSpan();
-  for (; m_ps->m_numDeferredTabs > 0; m_ps->m_numDeferredTabs--)
-    m_documentInterface->insertTab();
+  m_ps->m_textBuffer.flushDeferredTabs(*m_documentInterface);
   setFont(oldFont);
 }
 
 void MWAWTextListener::_flushText()
 {
-  if (m_ps->m_textBuffer.len() == 0) return;
-
-  // when some many ' ' follows each other, call insertSpace
-  librevenge::RVNGString tmpText;
-  int numConsecutiveSpaces = 0;
-  librevenge::RVNGString::Iter i(m_ps->m_textBuffer);
-  for (i.rewind(); i.next();) {
-    if (*(i()) == 0x20) // this test is compatible with unicode format
-      numConsecutiveSpaces++;
-    else
-      numConsecutiveSpaces = 0;
+  if (m_ps->m_textBuffer.empty()) return;
 
-    if (numConsecutiveSpaces > 1) {
-      if (tmpText.len() > 0) {
-        m_documentInterface->insertText(tmpText);
-        tmpText.clear();
-      }
-      m_documentInterface->insertSpace();
-    }
-    else
-      tmpText.append(i());
-  }
-  m_documentInterface->insertText(tmpText);
-  m_ps->m_textBuffer.clear();
+  m_ps->m_textBuffer.flush(*m_documentInterface);
 }
 
 ///////////////////
@@ -1135,6 +1117,9 @@ void MWAWTextListener::insertTextBox
 void MWAWTextListener::insertShape
 (MWAWPosition const &pos, MWAWGraphicShape const &shape, MWAWGraphicStyle const &style)
 {
+  // text only mode: nothing to do
+  if (m_parserState.m_textOnly)
+    return;
   // sanity check: avoid to send to many small pict
   float factor=pos.getScaleFactor(pos.unit(), librevenge::RVNG_POINT);
   if (pos.size()[0]*factor <= 8 && pos.size()[1]*factor <= 8 && m_ds->m_smallPictureNumber++ > 200) {
@@ -1233,6 +1218,9 @@ void MWAWTextListener::insertShape
 
 void MWAWTextListener::insertPicture(MWAWPosition const &pos, MWAWEmbeddedObject const &picture, MWAWGraphicStyle const &style)
 {
+  // text only mode: nothing to do
+  if (m_parserState.m_textOnly)
+    return;
   // sanity check: avoid to send to many small pict
   float factor=pos.getScaleFactor(pos.unit(), librevenge::RVNG_POINT);
   if (pos.size()[0]*factor <= 8 && pos.size()[1]*factor <= 8 && m_ds->m_smallPictureNumber++ > 200) {
@@ -1246,8 +1234,11 @@ void MWAWTextListener::insertPicture(MWAWPosition const &pos, MWAWEmbeddedObject
 
   if (!openFrame(pos, style)) return;
 
+  MWAWEmbeddedObject object(picture);
+  if (!m_parserState.m_rawBitmaps)
+    MWAWPictBitmap::encodeRawData(object, m_parserState.m_parseOptions);
   librevenge::RVNGPropertyList propList;
-  if (picture.addTo(propList))
+  if (object.addTo(propList))
     m_documentInterface->insertBinaryObject(propList);
   closeFrame();
 }
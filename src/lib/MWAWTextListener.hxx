@@ -135,6 +135,9 @@ public:
       \return the number of extra character read
    */
   int insertCharacter(unsigned char c, MWAWInputStreamPtr &input, long endPos=-1) final;
+  /** insert a run of characters using the font converter to find the utf8
+      characters (the SJIS characters are decoded as in insertCharacter(c, input, endPos)) */
+  void insertCharacters(uint8_t const *data, size_t len) final;
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   void insertUnicode(uint32_t character) final;
@@ -236,6 +239,8 @@ protected:
   void _closeParagraph();
   void _appendParagraphProperties(librevenge::RVNGPropertyList &propList, const bool isListElement=false);
   void _resetParagraphState(const bool isListElement=false);
+  /** low level: returns the style id of the current paragraph, defines it if it is not already done */
+  int _getParagraphStyleId();
 
   /** open a list level */
   void _openListElement();
@@ -253,6 +258,8 @@ protected:
   void _openSpan();
   /** low level: the function which closes the last opened span property */
   void _closeSpan();
+  /** low level: returns the style id of the current font, defines it if it is not already done */
+  int _getSpanStyleId();
 
   /** low level: flush the deferred text */
   void _flushText();
@@ -589,6 +589,8 @@ bool MacDrawProStyleManager::readFontStyles(MWAWEntry const &entry)
   }
 
   input->seek(pos, librevenge::RVNG_SEEK_SET);
+  // note: this function is called by checkHeader, so the flag must not be static
+  bool first=true;
   for (int j=0; j<N; ++j) {
     pos=input->tell();
     f.str("");
@@ -643,7 +645,6 @@ bool MacDrawProStyleManager::readFontStyles(MWAWEntry const &entry)
       val=static_cast<int>(input->readULong(2));
       MWAWColor color;
       if ((val&0xC000)==0x4000) {
-        static bool first=true;
         if (first) {
           MWAW_DEBUG_MSG(("MacDrawProStyleManager::readFontStyles: find some 4000 color\n"));
           first=false;
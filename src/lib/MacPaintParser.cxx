@@ -41,6 +41,7 @@
 
 #include "MWAWGraphicListener.hxx"
 #include "MWAWHeader.hxx"
+#include "MWAWPackBits.hxx"
 #include "MWAWPictBitmap.hxx"
 #include "MWAWPictData.hxx"
 #include "MWAWPosition.hxx"
@@ -198,78 +199,37 @@ bool MacPaintParser::readBitmap(bool onlyCheck)
 
   libmwaw::DebugStream f;
   // a bitmap is composed of 720 rows of (72x8bytes)
-  std::shared_ptr<MWAWPictBitmapIndexed> pict;
-  if (!onlyCheck) {
-    pict.reset(new MWAWPictBitmapIndexed(MWAWVec2i(576,720)));
-    std::vector<MWAWColor> colors(2);
-    colors[0]=MWAWColor::white();
-    colors[1]=MWAWColor::black();
-    pict->setColors(colors);
+  std::shared_ptr<MWAWPictBitmapBW> pict;
+  if (!onlyCheck)
+    pict.reset(new MWAWPictBitmapBW(MWAWVec2i(576,720)));
+  unsigned long numRead;
+  unsigned char const *data=endPos>512 ? input->read(static_cast<unsigned long>(endPos-512), numRead) : nullptr;
+  if (!data || numRead!=static_cast<unsigned long>(endPos-512)) {
+    MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read the bitmap data\n"));
+    return false;
   }
-
+  unsigned char const *ptr=data, *dataEnd=data+numRead;
+  unsigned char row[72];
   for (int r=0; r<720; ++r) {
-    long rowPos=input->tell();
+    long rowPos=512+long(ptr-data);
     f.str("");
     f << "Entries(Bitmap)-" << r << ":";
-    int col=0;
-    while (col<72*8) { // UnpackBits
-      if (input->tell()+2>endPos) {
-        MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-        f << "###";
-        ascii().addPos(rowPos);
-        ascii().addNote(f.str().c_str());
-        return false;
-      }
-      auto wh=static_cast<int>(input->readULong(1));
-      if (wh>=0x81) {
-        auto color=static_cast<int>(input->readULong(1));
-        if (onlyCheck) {
-          col+=8*(0x101-wh);
-          if (col>72*8)
-            return false;
-          continue;
-        }
-        for (int j=0; j < 0x101-wh; ++j) {
-          if (col>=72*8) {
-            MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-            f << "###";
-            ascii().addPos(rowPos);
-            ascii().addNote(f.str().c_str());
-            return false;
-          }
-          for (int b=7; b>=0; --b)
-            pict->set(col++, r, (color>>b)&1);
-        }
-      }
-      else { // checkme normally 0x80 is reserved and almost nobody used it (for ending the compression)
-        if (input->tell()+wh+1>endPos) {
-          MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-          f << "###";
-          ascii().addPos(rowPos);
-          ascii().addNote(f.str().c_str());
-          return false;
-        }
-        for (int j=0; j < wh+1; ++j) {
-          auto color=static_cast<int>(input->readULong(1));
-          if (col>=72*8) {
-            MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
-            f << "###";
-            ascii().addPos(rowPos);
-            ascii().addNote(f.str().c_str());
-            return false;
-          }
-          if (onlyCheck) {
-            col+=8;
-            continue;
-          }
-          for (int b=7; b>=0; --b)
-            pict->set(col++, r, (color>>b)&1);
-        }
-      }
+    size_t numWritten;
+    // checkme normally 0x80 is reserved and almost nobody used it (for ending the compression)
+    if (!libmwaw::PackBits::unpack(ptr, dataEnd, row, 72, numWritten, 1, libmwaw::PackBits::F_Literal0x80) || numWritten!=72) {
+      if (onlyCheck) return false;
+      MWAW_DEBUG_MSG(("MacPaintParser::readBitmap: can not read row %d\n", r));
+      f << "###";
+      ascii().addPos(rowPos);
+      ascii().addNote(f.str().c_str());
+      return false;
     }
+    if (pict)
+      pict->setRowPacked(r, row, row+72);
     ascii().addPos(rowPos);
     ascii().addNote(f.str().c_str());
   }
+  input->seek(512+long(ptr-data), librevenge::RVNG_SEEK_SET);
   if (!onlyCheck)
     m_state->m_bitmap=pict;
   return true;
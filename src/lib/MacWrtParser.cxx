@@ -33,6 +33,7 @@
 
 /* Inspired of TN-012-Disk-Based-MW-Format.txt */
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -1403,8 +1404,15 @@ bool MacWrtParser::readText(MacWrtParserInternal::Information const &info,
         MWAW_DEBUG_MSG(("MacWrtParser::readText: find bad character %d at pos=0x%lx\n", int(c), version()<=3 ? entry.begin()-4 : entry.begin()));
         f << "###[" << int(c) << "]";
       }
-      else
-        getTextListener()->insertCharacter(c);
+      else {
+        // send all the following characters which use the same font
+        int endRun = (actFormat < numFormat && listPos[size_t(actFormat)] > i) ? std::min(numChar, listPos[size_t(actFormat)]) : numChar;
+        int last = i+1;
+        while (last < endRun && static_cast<unsigned char>(text[size_t(last)]) >= 0x20)
+          ++last;
+        getTextListener()->insertCharacters(reinterpret_cast<uint8_t const *>(text.c_str())+i, size_t(last-i));
+        i = last-1;
+      }
     }
   }
 
@@ -1600,6 +1608,14 @@ bool MacWrtParser::readGraphic(MacWrtParserInternal::Information const &info)
   pictPos.setNaturalSize(naturalSize);
   f << pictPos;
 
+  if (getParserState()->m_textOnly) {
+    // text only mode: do not decode the picture, only send its end of line
+    if (getTextListener())
+      getTextListener()->insertEOL();
+    ascii().addPos(pos);
+    ascii().addNote(f.str().c_str());
+    return true;
+  }
   // get the picture
   input->seek(pos+8, librevenge::RVNG_SEEK_SET);
 
@@ -1620,6 +1620,8 @@ bool MacWrtProParser::sendPicture(std::shared_ptr<MacWrtProParserInternal::Zone>
   }
 
   zone->m_parsed = true;
+  // text only mode: do not decode the picture
+  if (getParserState()->m_textOnly) return true;
 
   // ok init is done
   auto &stream=zone->m_stream;
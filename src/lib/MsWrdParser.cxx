@@ -892,6 +892,17 @@ bool MsWrdParser::checkHeader(MWAWHeader *header, bool strict)
   return true;
 }
 
+bool MsWrdParser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  if (!getInput().get() || !checkHeader(nullptr) || !readZoneList())
+    return false;
+  auto it = m_entryMap.find("DocSum");
+  if (it == m_entryMap.end() || !readDocSum(it->second))
+    return false;
+  metaData=m_state->m_metaData;
+  return !metaData.empty();
+}
+
 ////////////////////////////////////////////////////////////
 // try to the end of the header
 ////////////////////////////////////////////////////////////
@@ -1881,6 +1892,9 @@ void MsWrdParser::sendPicture(long fPos, int cPos, MWAWPosition::AnchorTo anchor
     getTextListener()->insertComment(subdoc);
     return;
   }
+  // text only mode: do not decode the picture
+  if (getParserState()->m_textOnly)
+    return;
   if (m_state->m_picturesMap.find(fPos)==m_state->m_picturesMap.end()) {
     MWAW_DEBUG_MSG(("MsWrdParser::sendPicture: can not find picture for pos %lx\n", static_cast<long unsigned int>(fPos)));
     return;
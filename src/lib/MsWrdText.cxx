@@ -268,6 +268,32 @@ struct Property {
   bool m_debugPrint;
 };
 
+////////////////////////////////////////
+//! Internal: the property, paragraph and font which begin at a character position
+struct TextRun {
+  //! constructor
+  TextRun(long cPos, Property const &prop)
+    : m_cPos(cPos)
+    , m_property(&prop)
+    , m_paragraph(nullptr)
+    , m_font(nullptr)
+  {
+  }
+  //! comparison function used to find a character position
+  static bool compare(TextRun const &run, long cPos)
+  {
+    return run.m_cPos < cPos;
+  }
+  //! the character position
+  long m_cPos;
+  //! the property
+  Property const *m_property;
+  //! the paragraph (if it changes)
+  MsWrdStruct::Paragraph const *m_paragraph;
+  //! the font (if it changes)
+  MsWrdStruct::Font const *m_font;
+};
+
 ////////////////////////////////////////
 //! Internal and low level: a structure to store a line or a cell of a MsWrdText
 struct Line {
@@ -332,6 +358,7 @@ struct State {
     , m_fontMap()
     , m_paragraphMap()
     , m_propertyMap()
+    , m_textRunList()
     , m_tableCellPosSet()
     , m_tableMap()
     , m_paraInfoList()
@@ -436,6 +463,8 @@ struct State {
   std::map<long, MsWrdStruct::Paragraph> m_paragraphMap;
   //! the position where we have new data ( textpos -> [ we have done debug printing ])
   std::map<long, Property> m_propertyMap;
+  //! the list of text runs sorted by position: one run by entry of m_propertyMap
+  std::vector<TextRun> m_textRunList;
   //! a set of all begin cell position
   std::set<long> m_tableCellPosSet;
   //! the final correspondance table zone ( textpos, font)
@@ -1243,13 +1272,30 @@ bool MsWrdText::readLongZone(MsWrdEntry &entry, int sz, std::vector<long> &list)
 
   long pos = entry.begin();
   MWAWInputStreamPtr &input= m_parserState->m_input;
+  if (!input->checkPosition(entry.end())) {
+    MWAW_DEBUG_MSG(("MsWrdText::readLongZone: the zone %s seems too short\n", entry.type().c_str()));
+    return false;
+  }
   input->seek(pos, librevenge::RVNG_SEEK_SET);
   libmwaw::DebugFile &ascFile = m_parserState->m_asciiFile;
   libmwaw::DebugStream f;
   f << entry.type() << ":";
-  auto N = int(entry.length()/sz);
-  for (int i = 0; i < N; i++) {
-    auto val = static_cast<int>(input->readLong(sz));
+  auto N = size_t(entry.length()/sz);
+  std::vector<int32_t> values(N);
+  bool ok=false;
+  if (sz==4)
+    ok=input->readS32Array(values.data(), N);
+  else if (sz==2) {
+    std::vector<int16_t> shortValues(N);
+    ok=input->readS16Array(shortValues.data(), N);
+    std::copy(shortValues.begin(), shortValues.end(), values.begin());
+  }
+  if (!ok) { // unusual size
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
+    for (auto &val : values)
+      val = static_cast<int32_t>(input->readLong(sz));
+  }
+  for (auto val : values) {
     if (input->checkPosition(val))
       list.push_back(val);
     f << std::hex << val << std::dec << ",";
@@ -1875,6 +1921,23 @@ void MsWrdText::prepareData()
     pos+=(cNextPos-cPos);
     cPos = cNextPos;
   }
+
+  // finally, merge the property, the paragraph and the font maps in a list of runs
+  auto &runs=m_state->m_textRunList;
+  runs.clear();
+  runs.reserve(m_state->m_propertyMap.size());
+  auto paraIt=m_state->m_paragraphMap.begin();
+  auto fontIt=m_state->m_fontMap.begin();
+  for (auto const &it : m_state->m_propertyMap) {
+    runs.push_back(MsWrdTextInternal::TextRun(it.first, it.second));
+    auto &run=runs.back();
+    while (paraIt!=m_state->m_paragraphMap.end() && paraIt->first<it.first) ++paraIt;
+    if (paraIt!=m_state->m_paragraphMap.end() && paraIt->first==it.first)
+      run.m_paragraph=&paraIt->second;
+    while (fontIt!=m_state->m_fontMap.end() && fontIt->first<it.first) ++fontIt;
+    if (fontIt!=m_state->m_fontMap.end() && fontIt->first==it.first)
+      run.m_font=&fontIt->second;
+  }
 }
 
 ////////////////////////////////////////////////////////////
@@ -1898,19 +1961,23 @@ bool MsWrdText::sendText(MWAWEntry const &textEntry, bool mainZone, bool tableCe
   libmwaw::DebugStream f;
   f << "TextContent[" << cPos << "]:";
   long pictPos = -1;
+  // the runs are sorted by position, so we only need to advance a cursor
+  auto const &runs=m_state->m_textRunList;
+  auto runIt=std::lower_bound(runs.begin(), runs.end(), cPos, MsWrdTextInternal::TextRun::compare);
   while (!input->isEnd() && cPos < cEnd) {
     bool newTable = false;
     long cEndPos = cEnd;
 
-    MsWrdTextInternal::Property *prop = nullptr;
-    auto propIt = m_state->m_propertyMap.upper_bound(cPos);
-    if (propIt != m_state->m_propertyMap.end() && propIt->first < cEndPos && propIt->first > cPos)
-      cEndPos = propIt->first;
+    while (runIt!=runs.end() && runIt->m_cPos < cPos) ++runIt;
+    MsWrdTextInternal::TextRun const *run = (runIt!=runs.end() && runIt->m_cPos==cPos) ? &(*runIt) : nullptr;
+    auto nextIt = run ? runIt+1 : runIt;
+    if (nextIt != runs.end() && nextIt->m_cPos < cEndPos)
+      cEndPos = nextIt->m_cPos;
 
+    MsWrdTextInternal::Property const *prop = nullptr;
     size_t numPLC = 0;
-    propIt = m_state->m_propertyMap.find(cPos);
-    if (propIt != m_state->m_propertyMap.end()) {
-      prop = &propIt->second;
+    if (run) {
+      prop = run->m_property;
       pos = prop->m_fPos;
       newTable = !tableCell && m_state->getTable(cPos);
       input->seek(pos, librevenge::RVNG_SEEK_SET);
@@ -1976,12 +2043,26 @@ bool MsWrdText::sendText(MWAWEntry const &textEntry, bool mainZone, bool tableCe
       if (ok)
         continue;
     }
-    if (m_state->m_paragraphMap.find(cPos) != m_state->m_paragraphMap.end())
-      listener->setParagraph(m_state->m_paragraphMap.find(cPos)->second);
-    if (m_state->m_fontMap.find(cPos) != m_state->m_fontMap.end()) {
-      auto const &font = m_state->m_fontMap.find(cPos)->second;
-      pictPos = font.m_picturePos.get();
-      m_stylesManager->setProperty(font);
+    MsWrdStruct::Paragraph const *para=nullptr;
+    MsWrdStruct::Font const *font=nullptr;
+    if (run) {
+      para=run->m_paragraph;
+      font=run->m_font;
+    }
+    else {
+      // we are not at the beginning of a run (beginning of a zone, end of a table)
+      auto paraIt=m_state->m_paragraphMap.find(cPos);
+      if (paraIt != m_state->m_paragraphMap.end())
+        para=&paraIt->second;
+      auto fontIt=m_state->m_fontMap.find(cPos);
+      if (fontIt != m_state->m_fontMap.end())
+        font=&fontIt->second;
+    }
+    if (para)
+      listener->setParagraph(*para);
+    if (font) {
+      pictPos = font->m_picturePos.get();
+      m_stylesManager->setProperty(*font);
     }
     for (long p = cPos; p < cEndPos; p++) {
       auto c = static_cast<int>(input->readULong(1));
@@ -2072,9 +2153,31 @@ bool MsWrdText::sendText(MWAWEntry const &textEntry, bool mainZone, bool tableCe
       case 0x14: // apple logo ( note only in private zone)
         listener->insertUnicode(0xf8ff);
         break;
-      default:
-        p+=listener->insertCharacter(static_cast<unsigned char>(c), input, input->tell()+(cEndPos-1-p));
-        break;
+      default: {
+        long actPos=input->tell();
+        unsigned long numRead=0;
+        uint8_t const *data=nullptr;
+        if (c >= 0x20) {
+          input->seek(actPos-1, librevenge::RVNG_SEEK_SET);
+          data=input->read(size_t(cEndPos-p), numRead);
+        }
+        if (!data || !numRead) {
+          input->seek(actPos, librevenge::RVNG_SEEK_SET);
+          p+=listener->insertCharacter(static_cast<unsigned char>(c), input, input->tell()+(cEndPos-1-p));
+          break;
+        }
+        // send the following characters which are not special characters
+        auto numRun=long(1);
+        while (numRun < long(numRead) && data[numRun] >= 0x20)
+          ++numRun;
+        listener->insertCharacters(data, size_t(numRun));
+        f << std::string(reinterpret_cast<char const *>(data), size_t(numRun));
+        input->seek(actPos-1+numRun, librevenge::RVNG_SEEK_SET);
+        p+=numRun-1;
+        cPos+=numRun-1;
+        pos+=numRun-1;
+        continue;
+      }
       }
       if (c)
         f << char(c);
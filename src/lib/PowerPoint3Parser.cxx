@@ -3629,6 +3629,8 @@ void PowerPoint3Parser::sendSlides()
   }
 
   for (size_t i=0; i<m_state->m_slidesIdList.size(); ++i) {
+    if (!getParserState()->isPageSent(int(i)))
+      break;
     if (i>0)
       listener->insertBreak(MWAWListener::PageBreak);
     int id=m_state->m_slidesIdList[i];
@@ -3884,4 +3886,19 @@ bool PowerPoint3Parser::checkHeader(MWAWHeader *header, bool strict)
   return true;
 }
 
+bool PowerPoint3Parser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  MWAWInputStreamPtr input=getInput();
+  // only the structured files store a summary zone
+  if (!input || !input->isStructured() || !checkHeader(nullptr))
+    return false;
+  int fId=3;
+  if (!m_state->m_isMacFile)
+    fId=getFontConverter()->getId("CP1252");
+  PowerPoint3OLE oleParser(input, version(), getFontConverter(), fId);
+  oleParser.parse();
+  oleParser.updateMetaData(metaData);
+  return !metaData.empty();
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -1085,7 +1085,7 @@ bool PowerPoint7Graph::readStyle(int level, long lastPos)
         break;
       }
       auto const &picture=m_state->m_idToPictureMap.find(patGradId)->second;
-      MWAWGraphicStyle::Pattern pattern(picture.m_box.size(), picture.m_object.m_dataList[0], surfColors[0]);
+      MWAWGraphicStyle::Pattern pattern(picture.m_box.size(), picture.m_object, surfColors[0]);
       style->setPattern(pattern);
       break;
     }
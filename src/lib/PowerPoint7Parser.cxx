@@ -2823,8 +2823,11 @@ void PowerPoint7Parser::sendSlides()
     }
   }
   bool firstSlideSent=false;
+  int numSlides=0;
   for (auto const &id : m_state->m_slideList) {
     if (!id.isValid()) continue;
+    if (!getParserState()->isPageSent(numSlides++))
+      break;
     if (firstSlideSent)
       listener->insertBreak(MWAWListener::PageBreak);
     firstSlideSent=true;
@@ -2874,4 +2877,15 @@ bool PowerPoint7Parser::checkHeader(MWAWHeader *header, bool /*strict*/)
   return true;
 }
 
+bool PowerPoint7Parser::readMetaData(librevenge::RVNGPropertyList &metaData)
+{
+  MWAWInputStreamPtr input=getInput();
+  if (!input || !checkHeader(nullptr))
+    return false;
+  PowerPoint3OLE oleParser(input, version(), getFontConverter(), getFontConverter()->getId("CP1252"));
+  oleParser.parse();
+  oleParser.updateMetaData(metaData);
+  return !metaData.empty();
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
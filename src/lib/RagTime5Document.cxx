@@ -38,6 +38,7 @@
 #include <limits>
 #include <set>
 #include <sstream>
+#include <utility>
 
 #include <librevenge/librevenge.h>
 
@@ -2163,7 +2164,7 @@ bool RagTime5Document::unpackZone(RagTime5Zone &zone)
   if (input.get()==m_parser->getInput().get())
     ascii().skipZone(pos, endPos-1);
 
-  std::shared_ptr<MWAWStringStream> newStream(new MWAWStringStream(&newData[0], static_cast<unsigned int>(newData.size())));
+  std::shared_ptr<MWAWStringStream> newStream(new MWAWStringStream(std::move(newData)));
   MWAWInputStreamPtr newInput(new MWAWInputStream(newStream, false));
   zone.setInput(newInput);
   zone.m_entry.setBegin(0);
@@ -80,7 +80,10 @@ bool RagTime5StructManager::readCompressedLong(MWAWInputStreamPtr &input, long e
   val=long(input->readULong(1));
   if ((val&0xF0)==0xC0) {
     input->seek(-1, librevenge::RVNG_SEEK_CUR);
-    val=long(MWAWInputStream::readULong(input->input().get(), 4, 0, false)&0xFFFFFFF);
+    bool inverted=input->readInverted();
+    input->setReadInverted(false);
+    val=long(input->readULong(4)&0xFFFFFFF);
+    input->setReadInverted(inverted);
   }
   else if (val>=0xD0) { // never seems, but may be ok
     MWAW_DEBUG_MSG(("RagTime5Struct::readCompressedLong: can not read a long\n"));
@@ -336,20 +339,28 @@ bool RagTime5StructManager::readUnicodeString(MWAWInputStreamPtr input, long end
 bool RagTime5StructManager::readDataIdList(MWAWInputStreamPtr input, int n, std::vector<int> &listIds)
 {
   listIds.clear();
+  if (n<=0) return true;
   long pos=input->tell();
-  for (int i=0; i<n; ++i) {
-    int val=static_cast<int>(MWAWInputStream::readULong(input->input().get(), 2, 0, false));
-    if (val==0) {
+  bool inverted=input->readInverted();
+  input->setReadInverted(false);
+  std::vector<uint16_t> values(2*size_t(n));
+  if (!input->readU16Array(values.data(), values.size())) {
+    // the zone is truncated: the values after its end are read as 0
+    for (auto &val : values)
+      val=static_cast<uint16_t>(input->readULong(2));
+  }
+  input->setReadInverted(inverted);
+  for (size_t i=0; i<values.size(); i+=2) {
+    if (values[i]==0) {
       listIds.push_back(0);
-      input->seek(2, librevenge::RVNG_SEEK_CUR);
       continue;
     }
-    if (val!=1) {
+    if (values[i]!=1) {
       // update the position
       input->seek(pos+4*n, librevenge::RVNG_SEEK_SET);
       return false;
     }
-    listIds.push_back(static_cast<int>(MWAWInputStream::readULong(input->input().get(), 2, 0, false)));
+    listIds.push_back(static_cast<int>(values[i+1]));
   }
   return true;
 }
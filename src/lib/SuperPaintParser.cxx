@@ -918,14 +918,9 @@ bool SuperPaintParser::readBitmap(bool onlyCheck)
   ascii().addNote(f.str().c_str());
   input->seek(pos+19, librevenge::RVNG_SEEK_SET);
 
-  std::shared_ptr<MWAWPictBitmapIndexed> pict;
-  if (!onlyCheck) {
-    pict.reset(new MWAWPictBitmapIndexed(MWAWVec2i(pictDim[3],pictDim[2])));
-    std::vector<MWAWColor> colors(2);
-    colors[0]=MWAWColor::white();
-    colors[1]=MWAWColor::black();
-    pict->setColors(colors);
-  }
+  std::shared_ptr<MWAWPictBitmapBW> pict;
+  if (!onlyCheck)
+    pict.reset(new MWAWPictBitmapBW(MWAWVec2i(pictDim[3],pictDim[2])));
   while (!input->isEnd()) {
     pos=input->tell();
     f.str("");
@@ -979,7 +974,7 @@ bool SuperPaintParser::readBitmap(bool onlyCheck)
             for (int j=0; j < 0x101-wh; ++j) {
               for (int b=7; b>=0; --b) {
                 if (col<pictDim[3])
-                  pict->set(col, r, (color>>b)&1);
+                  pict->set(col, r, ((color>>b)&1)!=0);
                 ++col;
               }
             }
@@ -1002,7 +997,7 @@ bool SuperPaintParser::readBitmap(bool onlyCheck)
               auto color=static_cast<int>(input->readULong(1));
               for (int b=7; b>=0; --b) {
                 if (col<pictDim[3])
-                  pict->set(col, r, (color>>b)&1);
+                  pict->set(col, r, ((color>>b)&1)!=0);
                 ++col;
               }
             }
@@ -37,6 +37,7 @@
 #include <limits>
 #include <map>
 #include <sstream>
+#include <utility>
 
 #include <librevenge/librevenge.h>
 
@@ -2044,11 +2045,7 @@ bool WingzParser::decodeEncrypted()
     MWAW_DEBUG_MSG(("WingzParser::decodeEncrypted: can not read the buffer\n"));
     return false;
   }
-  std::unique_ptr<uint8_t[]> buffer{new uint8_t[size_t(length)]};
-  if (!buffer) {
-    MWAW_DEBUG_MSG(("WingzParser::decodeEncrypted: can not allocate a buffer\n"));
-    return false;
-  }
+  std::vector<uint8_t> buffer(static_cast<size_t>(length));
   // the first 12 bytes encoded
   for (size_t i=0; i<12; i++) buffer[i]=data[i];
   // reset the crypt flag to avoid problem
@@ -2063,8 +2060,7 @@ bool WingzParser::decodeEncrypted()
   }
 
   // finally replace the actual input with a new input
-  std::shared_ptr<librevenge::RVNGInputStream> newInput
-  (new MWAWStringStream(buffer.get(), static_cast<unsigned int>(length)));
+  std::shared_ptr<librevenge::RVNGInputStream> newInput(new MWAWStringStream(std::move(buffer)));
   getParserState()->m_input.reset(new MWAWInputStream(newInput, false));
   return true;
 }
@@ -633,6 +633,8 @@ bool WriteNowParser::parseGraphicZone(WriteNowEntry const &entry)
 ////////////////////////////////////////////////////////////
 bool WriteNowParser::sendPicture(WriteNowEntry const &entry, MWAWBox2i const &bdbox)
 {
+  // text only mode: do not decode the picture
+  if (getParserState()->m_textOnly) return true;
   MWAWInputStreamPtr input = getInput();
 
   if (!entry.valid() || entry.length() < 24) {
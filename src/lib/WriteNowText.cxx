@@ -1900,10 +1900,18 @@ bool WriteNowText::send(std::vector<WriteNowTextInternal::ContentZone> &listZone
           setProperty(ruler);
           actTabs = 0;
           break;
-        default:
-          listener->insertCharacter(c);
+        default: {
+          // send the following characters until the next tab or end of paragraph
+          unsigned char const *runStart = buffer-1;
+          long numRun = 1;
+          while (i+numRun < sz && runStart[numRun] != 0x9 && runStart[numRun] != 0xd)
+            f << runStart[numRun++];
+          listener->insertCharacters(runStart, size_t(numRun));
+          buffer += numRun-1;
+          i += numRun-1;
           break;
         }
+        }
       }
       ascFile.addPos(zone.m_pos[0]);
       ascFile.addNote(f.str().c_str());
@@ -60,7 +60,7 @@ uint8_t readU8(librevenge::RVNGInputStream *input)
   return *p;
 }
 
-void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
+int getUTF8(uint32_t val, char *outbuf)
 {
   uint8_t first;
   int len;
@@ -89,7 +89,6 @@ void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
     len = 6;
   }
 
-  char outbuf[7];
   int i;
   for (i = len - 1; i > 0; --i) {
     outbuf[i] = char((val & 0x3f) | 0x80);
@@ -97,6 +96,13 @@ void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
   }
   outbuf[0] = char(val | first);
   outbuf[len] = 0;
+  return len;
+}
+
+void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
+{
+  char outbuf[7];
+  getUTF8(val, outbuf);
   buffer.append(outbuf);
 }
 }
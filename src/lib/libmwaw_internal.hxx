@@ -157,6 +157,9 @@ class WrongPasswordException
 namespace libmwaw
 {
 uint8_t readU8(librevenge::RVNGInputStream *input);
+/** stores the UTF-8 encoding of an unicode character in outbuf (which must have a size of 7)
+    followed by a null character and returns the number of bytes of the encoding */
+int getUTF8(uint32_t val, char *outbuf);
 //! adds an unicode character to a string
 void appendUnicode(uint32_t val, librevenge::RVNGString &buffer);
 
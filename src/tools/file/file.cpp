@@ -31,9 +31,13 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
 
@@ -41,8 +45,10 @@
 #include "input.h"
 #include "ole.h"
 #include "rsrc.h"
+#include "threadpool.h"
 #include "xattr.h"
 
+#include <dirent.h>
 #include <sys/stat.h>
 
 #ifdef HAVE_CONFIG_H
@@ -71,6 +77,7 @@ struct File {
     , m_rsrcMissingMessage("")
     , m_rsrcResult("")
     , m_dataResult()
+    , m_fileSize(0)
     , m_printFileName(false)
   {
     if (m_fName.empty()) {
@@ -88,6 +95,7 @@ struct File {
       std::cerr << "File::File: the file " << m_fName << " is a not a regular file\n";
       throw libmwaw_tools::Exception();
     }
+    m_fileSize=static_cast<unsigned long long>(status.st_size);
   }
 
   //! operator<<
@@ -140,6 +148,8 @@ struct File {
     if (verbose <= 1) return false;
     return m_fileVersion.ok() || m_appliVersion.ok();
   }
+  //! returns the file type or "unknown"
+  std::string getResult() const;
   //! print the file type
   bool printResult(std::ostream &o, int verbose) const;
 
@@ -188,6 +198,8 @@ struct File {
 
   //! the result of the data analysis
   std::vector<std::string> m_dataResult;
+  //! the data fork size
+  unsigned long long m_fileSize;
 
   //! print or not the filename
   bool m_printFileName;
@@ -673,11 +685,12 @@ bool File::readDataInformation()
 {
   if (!m_fName.length())
     return false;
-  libmwaw_tools::FileStream input(m_fName.c_str());
-  if (!input.ok()) {
+  std::unique_ptr<InputStream> inputPtr(MappedFileStream::open(m_fName.c_str()));
+  if (!inputPtr) {
     MWAW_DEBUG_MSG(("File::readDataInformation: can not open the data fork\n"));
     return false;
   }
+  InputStream &input=*inputPtr;
   if (input.length() < 10)
     return true;
   input.seek(0, InputStream::SK_SET);
@@ -1205,29 +1218,34 @@ bool File::readRSRCInformation()
   return true;
 }
 
+std::string File::getResult() const
+{
+  if (m_fInfoResult.length())
+    return m_fInfoResult;
+  if (m_rsrcResult.length())
+    return m_rsrcResult;
+  if (m_dataResult.empty())
+    return "unknown";
+  std::stringstream o;
+  size_t num = m_dataResult.size();
+  if (num>1)
+    o << "[";
+  for (size_t i = 0; i < num; i++) {
+    o << m_dataResult[i];
+    if (i+1!=num)
+      o << ",";
+  }
+  if (num>1)
+    o << "]";
+  return o.str();
+}
+
 bool File::printResult(std::ostream &o, int verbose) const
 {
   if (!canPrintResult(verbose)) return false;
   if (m_printFileName)
     o << m_fName << ":";
-  if (m_fInfoResult.length())
-    o << m_fInfoResult;
-  else if (m_rsrcResult.length())
-    o << m_rsrcResult;
-  else if (m_dataResult.size()) {
-    size_t num = m_dataResult.size();
-    if (num>1)
-      o << "[";
-    for (size_t i = 0; i < num; i++) {
-      o << m_dataResult[i];
-      if (i+1!=num)
-        o << ",";
-    }
-    if (num>1)
-      o << "]";
-  }
-  else
-    o << "unknown";
+  o << getResult();
   if (verbose > 0) {
     if (m_fInfoCreator.length() || m_fInfoType.length())
       o << ":type=" << m_fInfoCreator << "["  << m_fInfoType << "]";
@@ -1241,18 +1259,262 @@ bool File::printResult(std::ostream &o, int verbose) const
   o << "\n";
   return true;
 }
+
+/** \brief the batch mode: analyses a list of files and directories
+    using a thread pool, and prints one line by file
+
+    \note the lines are printed when a file is analysed, so their order
+    can differ from the order of the files */
+struct Batch {
+  //! the output format
+  enum Format { F_JSON, F_TSV };
+  //! constructor
+  Batch(Format format, int numThreads)
+    : m_format(format)
+    , m_start(std::chrono::steady_clock::now())
+    , m_outputMutex()
+    , m_numFiles(0)
+    , m_numIdentified(0)
+    , m_numFailed(0)
+    , m_numBytes(0)
+    , m_pool(numThreads, 1024)
+  {
+  }
+  //! adds a file or a directory which is scanned recursively
+  void add(std::string const &path);
+  //! adds the files listed in a stream (one file by line)
+  void addList(std::istream &input);
+  //! waits until all files are analysed, then prints the statistics in std::cerr
+  void finish();
+protected:
+  //! adds the content of a directory
+  void addDirectory(std::string const &path);
+  //! adds a file
+  void addFile(std::string const &path);
+  //! analyses a file and prints the result
+  void process(std::string const &path);
+  //! returns the result line of a file (or of a file which can not be read)
+  std::string getLine(std::string const &path, File const *file) const;
+  //! returns a JSON string
+  static std::string getJSONString(std::string const &str);
+  //! returns a TSV field: replaces the tabulation and the end of lines by spaces
+  static std::string getTSVString(std::string const &str);
+
+  //! the output format
+  Format m_format;
+  //! the starting time
+  std::chrono::steady_clock::time_point m_start;
+  //! the mutex used to protect the output
+  std::mutex m_outputMutex;
+  //! the number of files
+  std::atomic<unsigned long> m_numFiles;
+  //! the number of identified files
+  std::atomic<unsigned long> m_numIdentified;
+  //! the number of files which can not be read
+  std::atomic<unsigned long> m_numFailed;
+  //! the number of bytes of the data forks
+  std::atomic<unsigned long long> m_numBytes;
+  //! the thread pool (must be destroyed first)
+  ThreadPool m_pool;
+private:
+  Batch(Batch const &) = delete;
+  Batch &operator=(Batch const &) = delete;
+};
+
+void Batch::add(std::string const &path)
+{
+  struct stat status;
+  if (stat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode))
+    addDirectory(path);
+  else
+    addFile(path);
+}
+
+void Batch::addList(std::istream &input)
+{
+  std::string line;
+  while (std::getline(input, line)) {
+    if (!line.empty() && line[line.size()-1]=='\r')
+      line.resize(line.size()-1);
+    if (!line.empty())
+      add(line);
+  }
+}
+
+void Batch::addDirectory(std::string const &path)
+{
+  DIR *dir=opendir(path.c_str());
+  if (!dir) {
+    std::cerr << "Batch::addDirectory: can not open the directory " << path << "\n";
+    return;
+  }
+  std::string prefix(path);
+  if (prefix.empty() || prefix[prefix.size()-1]!='/')
+    prefix+='/';
+  struct dirent *entry;
+  while ((entry=readdir(dir))!=nullptr) {
+    std::string name(entry->d_name);
+    if (name=="." || name=="..")
+      continue;
+    std::string child=prefix+name;
+    struct stat status;
+#ifndef _WIN32
+    if (lstat(child.c_str(), &status) != 0)
+      continue;
+    // do not follow the links to a directory to avoid loops
+    if (S_ISLNK(status.st_mode) && (stat(child.c_str(), &status) != 0 || S_ISDIR(status.st_mode)))
+      continue;
+#else
+    if (stat(child.c_str(), &status) != 0)
+      continue;
+#endif
+    if (S_ISDIR(status.st_mode))
+      addDirectory(child);
+    else if (S_ISREG(status.st_mode))
+      addFile(child);
+  }
+  closedir(dir);
+}
+
+void Batch::addFile(std::string const &path)
+{
+  m_pool.push([this,path]() {
+    process(path);
+  });
+}
+
+void Batch::process(std::string const &path)
+{
+  ++m_numFiles;
+  std::unique_ptr<File> file;
+  try {
+    file.reset(new File(path.c_str()));
+    file->readFileInformation();
+  }
+  catch (...) {
+    file.reset();
+  }
+  if (file) {
+    try {
+      file->readDataInformation();
+    }
+    catch (...) {
+    }
+    try {
+      file->readRSRCInformation();
+    }
+    catch (...) {
+    }
+    m_numBytes+=file->m_fileSize;
+    if (file->canPrintResult(0))
+      ++m_numIdentified;
+  }
+  else
+    ++m_numFailed;
+  std::string line=getLine(path, file.get());
+  std::lock_guard<std::mutex> lock(m_outputMutex);
+  std::cout << line;
+}
+
+void Batch::finish()
+{
+  m_pool.wait();
+  std::cout.flush();
+  double seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-m_start).count();
+  double mBytes=double(m_numBytes)/(1024.*1024.);
+  std::cerr << "mwawFile: " << m_numFiles << " files(" << m_numIdentified << " identified, "
+            << m_numFailed << " failed), " << std::fixed << std::setprecision(2) << mBytes << " MB in "
+            << seconds << " s";
+  if (seconds>0)
+    std::cerr << ": " << double(m_numFiles)/seconds << " files/s, " << mBytes/seconds << " MB/s";
+  std::cerr << " [" << m_pool.size() << " threads]\n";
+}
+
+std::string Batch::getLine(std::string const &path, File const *file) const
+{
+  std::stringstream s;
+  if (m_format==F_TSV) {
+    s << getTSVString(path) << "\t";
+    if (!file)
+      s << "error: can not read the file\t\t";
+    else
+      s << getTSVString(file->getResult()) << "\t" << getTSVString(file->m_fInfoCreator) << "\t" << getTSVString(file->m_fInfoType);
+    s << "\n";
+    return s.str();
+  }
+  s << "{\"file\":" << getJSONString(path);
+  if (!file)
+    s << ",\"error\":\"can not read the file\"";
+  else {
+    s << ",\"result\":" << getJSONString(file->getResult());
+    s << ",\"creator\":" << getJSONString(file->m_fInfoCreator);
+    s << ",\"type\":" << getJSONString(file->m_fInfoType);
+    s << ",\"rsrc\":" << getJSONString(file->m_rsrcResult);
+    s << ",\"data\":[";
+    for (size_t i=0; i<file->m_dataResult.size(); ++i)
+      s << (i ? "," : "") << getJSONString(file->m_dataResult[i]);
+    s << "]";
+  }
+  s << "}\n";
+  return s.str();
+}
+
+std::string Batch::getJSONString(std::string const &str)
+{
+  std::stringstream s;
+  s << '"';
+  size_t len=str.size();
+  for (size_t i=0; i<len; ++i) {
+    auto c=static_cast<unsigned char>(str[i]);
+    if (c>=0x80) {
+      // keep the valid UTF-8 sequences, the other characters are probably MacRoman/Latin1 characters
+      size_t n=(c&0xe0)==0xc0 ? 1 : (c&0xf0)==0xe0 ? 2 : (c&0xf8)==0xf0 ? 3 : 0;
+      bool ok=n>0 && i+n<len;
+      for (size_t j=1; ok && j<=n; ++j)
+        ok=(static_cast<unsigned char>(str[i+j])&0xc0)==0x80;
+      if (ok) {
+        s << str.substr(i, n+1);
+        i+=n;
+        continue;
+      }
+    }
+    if (c=='"' || c=='\\')
+      s << '\\' << char(c);
+    else if (c<0x20 || c>=0x80)
+      s << "\\u" << std::hex << std::setfill('0') << std::setw(4) << int(c) << std::dec;
+    else
+      s << char(c);
+  }
+  s << '"';
+  return s.str();
+}
+
+std::string Batch::getTSVString(std::string const &str)
+{
+  std::string res(str);
+  for (auto &c : res) {
+    if (c=='\t' || c=='\n' || c=='\r')
+      c=' ';
+  }
+  return res;
+}
 }
 
 static void usage(char const *fName)
 {
   std::cerr << "Usage: " << fName << " [OPTION] FILENAME\n";
+  std::cerr << "       " << fName << " -b [OPTION] [FILENAME|DIRECTORY]...\n";
   std::cerr << "\n";
   std::cerr << "try to find the file type of FILENAME\n";
   std::cerr << "\n";
   std::cerr << "Options:\n";
+  std::cerr << "\t -b: Batch mode: analyses the files and the directories' files, prints one line by file,\n";
   std::cerr << "\t -f: Does not print the filename,\n";
   std::cerr << "\t -F: Prints the filename[default],\n";
   std::cerr << "\t -h: Shows this help message,\n";
+  std::cerr << "\t -jNum: Batch mode: defines the number of threads[default: number of cores],\n";
+  std::cerr << "\t -lFile: Batch mode: reads the list of files in File(- for the standard input),\n";
+  std::cerr << "\t -oFormat: Batch mode: defines the output format: json[default] or tsv,\n";
   std::cerr << "\t -v: Output mwawFile version\n";
   std::cerr << "\t -wNum: define the verbose level.\n";
 }
@@ -1265,14 +1527,35 @@ static int printVersion()
 
 int main(int argc, char *const argv[])
 {
-  int ch, verbose=0;
-  bool printFileName=true;
+  int ch, verbose=0, numThreads=0;
+  bool printFileName=true, batch=false;
+  std::string listFile;
+  auto format=libmwaw_tools::Batch::F_JSON;
 
-  while ((ch = getopt(argc, argv, "fFhvw:")) != -1) {
+  while ((ch = getopt(argc, argv, "bfFhj:l:o:vw:")) != -1) {
     switch (ch) {
     case 'w':
       verbose=atoi(optarg);
       break;
+    case 'b':
+      batch = true;
+      break;
+    case 'j':
+      numThreads=atoi(optarg);
+      break;
+    case 'l':
+      listFile=optarg;
+      batch = true;
+      break;
+    case 'o':
+      if (strcmp(optarg, "json")==0)
+        format=libmwaw_tools::Batch::F_JSON;
+      else if (strcmp(optarg, "tsv")==0)
+        format=libmwaw_tools::Batch::F_TSV;
+      else
+        verbose=-1;
+      batch = true;
+      break;
     case 'f':
       printFileName = false;
       break;
@@ -1289,6 +1572,27 @@ int main(int argc, char *const argv[])
       break;
     }
   }
+  if (batch) {
+    if ((argc == optind && listFile.empty()) || verbose < 0) {
+      usage(argv[0]);
+      return -1;
+    }
+    libmwaw_tools::Batch batchFiles(format, numThreads);
+    if (listFile=="-")
+      batchFiles.addList(std::cin);
+    else if (!listFile.empty()) {
+      std::ifstream list(listFile.c_str());
+      if (!list.is_open()) {
+        std::cerr << argv[0] << ": can not open the list " << listFile << "\n";
+        return -1;
+      }
+      batchFiles.addList(list);
+    }
+    for (int i=optind; i<argc; ++i)
+      batchFiles.add(argv[i]);
+    batchFiles.finish();
+    return 0;
+  }
   if (argc != 1+optind || verbose < 0) {
     usage(argv[0]);
     return -1;
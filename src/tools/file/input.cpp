@@ -29,10 +29,19 @@
 
 #include <string.h>
 #include <iostream>
+#include <memory>
 
 #include "file_internal.h"
 #include "input.h"
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#  define MWAW_USE_MMAP 1
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 namespace libmwaw_tools
 {
 //
@@ -222,5 +231,79 @@ long FileStream::length()
   }
   return long(ftell(m_file));
 }
+
+//
+// MappedFileStream
+//
+MappedFileStream::MappedFileStream(char const *path)
+  : InputStream()
+  , m_data(nullptr)
+  , m_dataSize(0)
+  , m_isOk(false)
+{
+#ifdef MWAW_USE_MMAP
+  if (!path) return;
+  int fd=::open(path, O_RDONLY);
+  if (fd<0) {
+    MWAW_DEBUG_MSG(("MappedFileStream::MappedFileStream: can not open %s\n", path));
+    return;
+  }
+  struct stat status;
+  if (fstat(fd, &status)!=0 || !S_ISREG(status.st_mode) || status.st_size<0 ||
+      static_cast<unsigned long long>(status.st_size)>static_cast<unsigned long long>(0x7fffffff)) {
+    ::close(fd);
+    return;
+  }
+  if (status.st_size==0) {
+    ::close(fd);
+    m_isOk=true;
+    return;
+  }
+  void *data=mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data==MAP_FAILED) {
+    MWAW_DEBUG_MSG(("MappedFileStream::MappedFileStream: can not map %s\n", path));
+    return;
+  }
+  m_data=static_cast<unsigned char const *>(data);
+  m_dataSize=long(status.st_size);
+  m_isOk=true;
+#else
+  (void) path;
+#endif
+}
+
+MappedFileStream::~MappedFileStream()
+{
+#ifdef MWAW_USE_MMAP
+  if (m_data)
+    munmap(const_cast<unsigned char *>(m_data), size_t(m_dataSize));
+#endif
+}
+
+unsigned char const *MappedFileStream::read(unsigned long numBytes, unsigned long &numBytesRead)
+{
+  numBytesRead = 0;
+  if (!m_data || numBytes == 0 || m_offset >= m_dataSize)
+    return nullptr;
+  auto numBytesToRead = static_cast<unsigned long>(m_dataSize-m_offset);
+  if (numBytes < numBytesToRead)
+    numBytesToRead = numBytes;
+  unsigned char const *res = m_data+m_offset;
+  m_offset += long(numBytesToRead);
+  numBytesRead = numBytesToRead;
+  return res;
+}
+
+InputStream *MappedFileStream::open(char const *path)
+{
+  std::unique_ptr<MappedFileStream> mapped(new MappedFileStream(path));
+  if (mapped->ok())
+    return mapped.release();
+  std::unique_ptr<FileStream> file(new FileStream(path));
+  if (file->ok())
+    return file.release();
+  return nullptr;
+}
 }
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
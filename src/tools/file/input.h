@@ -114,6 +114,36 @@ private:
   FileStream &operator=(const FileStream &) = delete;
 };
 
+/** a read-only stream which maps a file in memory when possible
+
+    \note this avoids one read call per buffer when we only need to
+    look at some bytes of a lot of files, the mapping is done lazily
+    by the system, so only the pages which are read are loaded */
+class MappedFileStream final : public InputStream
+{
+public:
+  explicit MappedFileStream(char const *path);
+  ~MappedFileStream() final;
+  bool ok() const
+  {
+    return m_isOk;
+  }
+  unsigned char const *read(unsigned long numBytes, unsigned long &numBytesRead) final;
+  long length() final
+  {
+    return m_dataSize;
+  }
+  //! returns a mapped file stream if possible or a file stream
+  static InputStream *open(char const *path);
+private:
+  unsigned char const *m_data;
+  long m_dataSize;
+  bool m_isOk;
+
+  MappedFileStream(const MappedFileStream &) = delete;
+  MappedFileStream &operator=(const MappedFileStream &) = delete;
+};
+
 }
 #endif
 
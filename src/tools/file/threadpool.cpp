@@ -0,0 +1,161 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw: tools
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <system_error>
+
+#include "file_internal.h"
+#include "threadpool.h"
+
+namespace libmwaw_tools
+{
+ThreadPool::ThreadPool(int numThreads, size_t maxPending)
+  : m_queues()
+  , m_threads()
+  , m_mutex()
+  , m_taskCondition()
+  , m_doneCondition()
+  , m_numQueued(0)
+  , m_numPending(0)
+  , m_maxPending(maxPending)
+  , m_nextQueue(0)
+  , m_stop(false)
+{
+  if (numThreads<=0)
+    numThreads=int(std::thread::hardware_concurrency());
+  if (numThreads<=0)
+    numThreads=1;
+  for (int i=0; i<numThreads; ++i)
+    m_queues.push_back(std::unique_ptr<Queue>(new Queue));
+  for (size_t i=0; i<m_queues.size(); ++i) {
+    try {
+      m_threads.push_back(std::thread(&ThreadPool::run, this, i));
+    }
+    catch (std::system_error const &) {
+      MWAW_DEBUG_MSG(("ThreadPool::ThreadPool: can not create the thread %d\n", int(i)));
+      break;
+    }
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop=true;
+  }
+  m_taskCondition.notify_all();
+  for (auto &thread : m_threads)
+    thread.join();
+}
+
+void ThreadPool::push(Task task)
+{
+  if (m_threads.empty()) {
+    task();
+    return;
+  }
+  size_t id;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_maxPending)
+      m_doneCondition.wait(lock, [this] { return m_numPending<m_maxPending; });
+    ++m_numPending;
+    id=(m_nextQueue++)%m_threads.size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_queues[id]->m_mutex);
+    m_queues[id]->m_tasks.push_back(std::move(task));
+  }
+  // the task must be in a queue before being counted, see run
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_numQueued;
+  }
+  m_taskCondition.notify_one();
+}
+
+void ThreadPool::wait()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_doneCondition.wait(lock, [this] { return m_numPending==0; });
+}
+
+bool ThreadPool::pop(size_t id, Task &task)
+{
+  {
+    Queue &queue=*m_queues[id];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    if (!queue.m_tasks.empty()) {
+      task=std::move(queue.m_tasks.back());
+      queue.m_tasks.pop_back();
+      return true;
+    }
+  }
+  for (size_t i=1; i<m_queues.size(); ++i) {
+    Queue &queue=*m_queues[(id+i)%m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    if (!queue.m_tasks.empty()) {
+      task=std::move(queue.m_tasks.front());
+      queue.m_tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::run(size_t id)
+{
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taskCondition.wait(lock, [this] { return m_stop || m_numQueued>0; });
+      if (m_numQueued==0)
+        return;
+      // we own a task, which is already stored in one queue
+      --m_numQueued;
+    }
+    Task task;
+    while (!pop(id, task))
+      std::this_thread::yield();
+    try {
+      task();
+    }
+    catch (...) {
+      MWAW_DEBUG_MSG(("ThreadPool::run: a task throws an exception\n"));
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      --m_numPending;
+    }
+    m_doneCondition.notify_all();
+  }
+}
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libmwaw: tools
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#ifndef MWAW_THREADPOOL_H
+#  define MWAW_THREADPOOL_H
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libmwaw_tools
+{
+/** \brief a small work-stealing thread pool
+
+    Each worker has its own queue: the tasks are pushed in these queues
+    in a round-robin way, a worker takes its tasks from the back of its
+    queue and, when its queue is empty, steals a task from the front of
+    the other queues.
+ */
+class ThreadPool
+{
+public:
+  //! a task
+  typedef std::function<void()> Task;
+  /** constructor: numThreads<=0 means one thread by hardware thread,
+      maxPending is the maximum number of tasks which are waiting or running
+      before push blocks (0 means no limit) */
+  explicit ThreadPool(int numThreads, size_t maxPending=0);
+  //! destructor: waits for all the tasks, then stops the threads
+  ~ThreadPool();
+  //! returns the number of threads
+  size_t size() const
+  {
+    return m_threads.size();
+  }
+  /** adds a new task
+
+      \note if the pool has no thread, the task is directly executed */
+  void push(Task task);
+  //! waits until all the tasks are done
+  void wait();
+protected:
+  //! the queue of a worker
+  struct Queue {
+    //! constructor
+    Queue()
+      : m_mutex()
+      , m_tasks()
+    {
+    }
+    //! the mutex which protects the queue
+    std::mutex m_mutex;
+    //! the list of tasks
+    std::deque<Task> m_tasks;
+  };
+  //! the function called by each thread
+  void run(size_t id);
+  //! tries to find a task in the worker's queue or in the other queues
+  bool pop(size_t id, Task &task);
+
+  //! the worker queues
+  std::vector<std::unique_ptr<Queue> > m_queues;
+  //! the threads
+  std::vector<std::thread> m_threads;
+  //! the mutex which protects the counters
+  std::mutex m_mutex;
+  //! the condition used to signal that a task is added or that the pool stops
+  std::condition_variable m_taskCondition;
+  //! the condition used to signal that a task is done
+  std::condition_variable m_doneCondition;
+  //! the number of tasks in the queues
+  size_t m_numQueued;
+  //! the number of tasks waiting or running
+  size_t m_numPending;
+  //! the maximum number of pending tasks
+  size_t m_maxPending;
+  //! the next queue which receives a task
+  size_t m_nextQueue;
+  //! a flag to know if the threads must stop
+  bool m_stop;
+private:
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+};
+}
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab: